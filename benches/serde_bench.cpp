@@ -0,0 +1,193 @@
+// Benchmark driver for the BuFFI serde runtime and the generated wrappers.
+//
+// Build and run with `make run` in this directory. The FFI round-trip
+// benchmark needs the compiled example staticlib and is only built by the
+// `bench_ffi` target (see the Makefile).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BUFFI_NAMESPACE.hpp"
+
+#ifdef BUFFI_BENCH_FFI
+#include "buffi_example_testclient.hpp"
+#endif
+
+using namespace BUFFI_NAMESPACE;
+
+namespace {
+
+// Keeps the compiler from optimizing a benchmarked value away
+template <typename T>
+void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs `fn` `iters` times and prints ns/op plus GB/s based on the number of
+// payload bytes a single operation touches
+template <typename F>
+void bench(const char *name, size_t bytes_per_op, size_t iters, F fn) {
+    using clock = std::chrono::steady_clock;
+    // warm-up: populates the buffer pool and faults in the payload pages
+    fn();
+    auto start = clock::now();
+    for (size_t i = 0; i < iters; ++i) {
+        fn();
+    }
+    auto end = clock::now();
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double ns_per_op = ns / (double)iters;
+    double gb_per_s = ns_per_op > 0.0 ? (double)bytes_per_op / ns_per_op : 0.0;
+    std::printf("%-48s %12.1f ns/op %8.3f GB/s\n", name, ns_per_op, gb_per_s);
+}
+
+template <typename T>
+std::vector<uint8_t> serialize_value(const T &value) {
+    auto serializer = serde::BincodeSerializer(serde::BufferPool::acquire());
+    serializer.reserve(serde::serialized_size(value));
+    serde::Serializable<T>::serialize(value, serializer);
+    return std::move(serializer).bytes();
+}
+
+template <typename T>
+void round_trip(const T &value) {
+    std::vector<uint8_t> bytes = serialize_value(value);
+    auto deserializer = serde::BincodeDeserializer(bytes.data(), bytes.size());
+    T out = serde::Deserializable<T>::deserialize(deserializer);
+    do_not_optimize(out);
+    serde::BufferPool::release(std::move(bytes));
+}
+
+void bench_scalars() {
+    constexpr size_t n = 4096;
+    bench("serialize u64 x4096", n * sizeof(uint64_t), 10000, [] {
+        auto serializer = serde::BincodeSerializer(serde::BufferPool::acquire());
+        serializer.reserve(n * sizeof(uint64_t));
+        for (size_t i = 0; i < n; ++i) {
+            serializer.serialize_u64(i);
+        }
+        serde::BufferPool::release(std::move(serializer).bytes());
+    });
+    std::vector<uint8_t> bytes;
+    {
+        auto serializer = serde::BincodeSerializer();
+        for (size_t i = 0; i < n; ++i) {
+            serializer.serialize_u64(i);
+        }
+        bytes = std::move(serializer).bytes();
+    }
+    bench("deserialize u64 x4096", n * sizeof(uint64_t), 10000, [&] {
+        auto deserializer = serde::BincodeDeserializer(bytes.data(), bytes.size());
+        uint64_t acc = 0;
+        for (size_t i = 0; i < n; ++i) {
+            acc += deserializer.deserialize_u64();
+        }
+        do_not_optimize(acc);
+    });
+}
+
+void bench_vectors() {
+    struct Size {
+        const char *label;
+        size_t elements;
+        size_t iters;
+    };
+    constexpr Size sizes[] = {
+        {"1K", 1'000, 20000},
+        {"1M", 1'000'000, 200},
+        {"100M", 100'000'000, 3},
+    };
+    for (const auto &size : sizes) {
+        std::vector<uint8_t> payload(size.elements);
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = (uint8_t)i;
+        }
+        std::string name = std::string("round-trip std::vector<uint8_t> ") + size.label;
+        bench(name.c_str(), size.elements, size.iters, [&] { round_trip(payload); });
+    }
+    for (const auto &size : sizes) {
+        if (size.elements > 1'000'000) {
+            continue;
+        }
+        std::vector<double> payload(size.elements);
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = (double)i;
+        }
+        std::string name = std::string("round-trip std::vector<double> ") + size.label;
+        bench(name.c_str(), size.elements * sizeof(double), size.iters, [&] {
+            round_trip(payload);
+        });
+    }
+}
+
+void bench_strings() {
+    std::string ascii(1'000'000, 'a');
+    bench("round-trip ASCII string 1M", ascii.size(), 200, [&] { round_trip(ascii); });
+
+    std::string mixed;
+    mixed.reserve(1'000'000);
+    while (mixed.size() + 5 < 1'000'000) {
+        mixed += "ab\xc3\xa4\xe2\x82\xac"; // "abä€"
+    }
+    bench("round-trip mixed UTF-8 string 1M", mixed.size(), 200, [&] { round_trip(mixed); });
+}
+
+void bench_variants() {
+    constexpr size_t n = 10'000;
+    std::vector<Result_CustomType_SerializableError> payload;
+    payload.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        Result_CustomType_SerializableError res;
+        if (i % 4 == 3) {
+            Result_CustomType_SerializableError::Err err;
+            err.value = std::make_tuple(SerializableError{"benchmark error"});
+            res.value = err;
+        } else {
+            CustomType custom;
+            custom.some_content = (int64_t)i;
+            custom.itself = std::nullopt;
+            if (i % 2 == 0) {
+                custom.random_enum.value = RandomEnum::NoValue{};
+            } else {
+                custom.random_enum.value = RandomEnum::TimeStamp{DateTimeHelper{(int64_t)i}};
+            }
+            custom.proxy = DateTimeHelper{(int64_t)i};
+            custom.overwrite = "overwritten";
+            custom.overwrite_2 = {"nested", "strings"};
+            Result_CustomType_SerializableError::Ok ok;
+            ok.value = std::make_tuple(std::move(custom));
+            res.value = ok;
+        }
+        payload.push_back(std::move(res));
+    }
+    size_t encoded_size = serde::serialized_size(payload);
+    bench("round-trip 10K Result_CustomType variants", encoded_size, 200, [&] {
+        round_trip(payload);
+    });
+}
+
+#ifdef BUFFI_BENCH_FFI
+void bench_ffi() {
+    TestClientHolder client(get_test_client());
+    std::string input = "benchmark input";
+    bench("FFI round-trip buffi_client_function", input.size(), 20000, [&] {
+        do_not_optimize(client.client_function(input));
+    });
+}
+#endif
+
+} // namespace
+
+int main() {
+    bench_scalars();
+    bench_vectors();
+    bench_strings();
+    bench_variants();
+#ifdef BUFFI_BENCH_FFI
+    bench_ffi();
+#endif
+    return 0;
+}
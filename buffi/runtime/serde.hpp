@@ -0,0 +1,1507 @@
+// Copyright (c) Facebook, Inc. and its affiliates
+// SPDX-License-Identifier: MIT OR Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// --- Instrumentation hooks for the generated wrappers ---
+//
+// Define BUFFI_INSTRUMENT_CALL before including this header to receive one
+// invocation per generated call with
+//   (function_id, arg_bytes, res_bytes, serialize_dur, ffi_dur, deserialize_dur)
+// where function_id is a string literal naming the API function, the byte
+// counts are size_t and the durations are std::chrono::steady_clock
+// differences for the serialize / FFI-boundary / deserialize phase of the
+// call. When the macro is not defined, every hook expands to nothing and
+// the wrappers compile exactly as without instrumentation.
+#ifdef BUFFI_INSTRUMENT_CALL
+#define BUFFI_INSTRUMENT_TIMESTAMP(name) \
+    const auto name = std::chrono::steady_clock::now()
+#define BUFFI_INSTRUMENT_BYTES(name, expr) const size_t name = (expr)
+#else
+#define BUFFI_INSTRUMENT_CALL(function_id, arg_bytes, res_bytes, \
+                              serialize_dur, ffi_dur, deserialize_dur)
+#define BUFFI_INSTRUMENT_TIMESTAMP(name)
+#define BUFFI_INSTRUMENT_BYTES(name, expr)
+#endif
+
+namespace serde {
+
+class serialization_error : public std::invalid_argument {
+  public:
+    explicit serialization_error(const std::string &what_arg)
+        : std::invalid_argument(what_arg) {}
+    explicit serialization_error(const char *what_arg)
+        : std::invalid_argument(what_arg) {}
+};
+
+class deserialization_error : public std::invalid_argument {
+  public:
+    explicit deserialization_error(const std::string &what_arg)
+        : std::invalid_argument(what_arg) {}
+    explicit deserialization_error(const char *what_arg)
+        : std::invalid_argument(what_arg) {}
+};
+
+// Basic implementation for 128-bit unsigned integers.
+struct uint128_t {
+    uint64_t high;
+    uint64_t low;
+
+    friend bool operator==(const uint128_t &, const uint128_t &);
+};
+
+inline bool operator==(const uint128_t &lhs, const uint128_t &rhs) {
+    return lhs.high == rhs.high && lhs.low == rhs.low;
+}
+
+// 128-bit signed integers.
+struct int128_t {
+    int64_t high;
+    uint64_t low;
+
+    friend bool operator==(const int128_t &, const int128_t &);
+};
+
+inline bool operator==(const int128_t &lhs, const int128_t &rhs) {
+    return lhs.high == rhs.high && lhs.low == rhs.low;
+}
+
+// A copyable unique_ptr with value semantics.
+// Freely inspired by the following discussion:
+// https://codereview.stackexchange.com/questions/103744/deepptr-a-deep-copying-unique-ptr-wrapper-in-c
+template <typename T>
+class value_ptr {
+  public:
+    value_ptr() : ptr_(nullptr) {}
+
+    value_ptr(const T &value) : ptr_(new T{value}) {}
+
+    value_ptr(const value_ptr &other) : ptr_(nullptr) {
+        if (other) {
+            ptr_ = std::unique_ptr<T>{new T{*other}};
+        }
+    }
+
+    value_ptr &operator=(const value_ptr &other) {
+        value_ptr temp{other};
+        std::swap(ptr_, temp.ptr_);
+        return *this;
+    }
+
+    value_ptr(value_ptr &&other) = default;
+
+    value_ptr &operator=(value_ptr &&other) = default;
+
+    T &operator*() { return *ptr_; }
+
+    const T &operator*() const { return *ptr_; }
+
+    T *const operator->() { return ptr_.operator->(); }
+
+    const T *const operator->() const { return ptr_.operator->(); }
+
+    const T *const get() const { return ptr_.get(); }
+
+    operator bool() const { return (bool)ptr_; }
+
+    template <typename U>
+    friend bool operator==(const value_ptr<U> &, const value_ptr<U> &);
+
+  private:
+    std::unique_ptr<T> ptr_;
+};
+
+template <typename T>
+bool operator==(const value_ptr<T> &lhs, const value_ptr<T> &rhs) {
+    return *lhs == *rhs;
+}
+
+// A copy-on-write sibling of `value_ptr`, selected for the generated types
+// via `Config::cow_value_ptr`. Copies share the pointee and only clone it
+// when a mutable accessor is used while shared, so copying a deeply
+// recursive value costs one reference bump instead of one allocation per
+// node.
+template <typename T>
+class cow_ptr {
+  public:
+    cow_ptr() : ptr_(nullptr) {}
+
+    cow_ptr(const T &value) : ptr_(std::make_shared<T>(value)) {}
+
+    cow_ptr(const cow_ptr &other) = default;
+
+    cow_ptr &operator=(const cow_ptr &other) = default;
+
+    cow_ptr(cow_ptr &&other) = default;
+
+    cow_ptr &operator=(cow_ptr &&other) = default;
+
+    T &operator*() {
+        detach();
+        return *ptr_;
+    }
+
+    const T &operator*() const { return *ptr_; }
+
+    T *const operator->() {
+        detach();
+        return ptr_.operator->();
+    }
+
+    const T *const operator->() const { return ptr_.operator->(); }
+
+    const T *const get() const { return ptr_.get(); }
+
+    operator bool() const { return (bool)ptr_; }
+
+    template <typename U>
+    friend bool operator==(const cow_ptr<U> &, const cow_ptr<U> &);
+
+  private:
+    // Clone the pointee before handing out a mutable reference while it is
+    // shared with other copies.
+    void detach() {
+        if (ptr_ && ptr_.use_count() > 1) {
+            ptr_ = std::make_shared<T>(*ptr_);
+        }
+    }
+
+    std::shared_ptr<T> ptr_;
+};
+
+template <typename T>
+bool operator==(const cow_ptr<T> &lhs, const cow_ptr<T> &rhs) {
+    return *lhs == *rhs;
+}
+
+// A small thread-local pool of byte buffers. The generated wrappers acquire
+// a buffer per serialized argument and hand it back after the call, so hot
+// call paths reuse warmed buffers instead of allocating fresh vectors.
+class BufferPool {
+  public:
+    static std::vector<uint8_t> acquire() {
+        auto &buffers = pool();
+        if (buffers.empty()) {
+            return std::vector<uint8_t>();
+        }
+        std::vector<uint8_t> buffer = std::move(buffers.back());
+        buffers.pop_back();
+        return buffer;
+    }
+
+    static void release(std::vector<uint8_t> buffer) {
+        auto &buffers = pool();
+        if (buffers.size() < max_pooled_buffers) {
+            buffers.push_back(std::move(buffer));
+        }
+    }
+
+  private:
+    static constexpr size_t max_pooled_buffers = 8;
+
+    static std::vector<std::vector<uint8_t>> &pool() {
+        thread_local std::vector<std::vector<uint8_t>> buffers;
+        return buffers;
+    }
+};
+
+// Trait to enable serialization of values of type T.
+// This is similar to the `serde::Serialize` trait in Rust.
+template <typename T>
+struct Serializable {
+    template <typename Serializer>
+    static void serialize(const T &value, Serializer &serializer);
+};
+
+// Trait to enable deserialization of values of type T.
+// This is similar to the `serde::Deserialize` trait in Rust.
+template <typename T>
+struct Deserializable {
+    template <typename Deserializer>
+    static T deserialize(Deserializer &deserializer);
+
+    // Storage-reusing counterpart of `deserialize`: assigns into an existing
+    // object instead of constructing a fresh one. Prefer calling the free
+    // function `serde::deserialize_into`, which falls back to
+    // deserialize-and-assign for types without a dedicated implementation.
+    template <typename Deserializer>
+    static void deserialize_into(T &out, Deserializer &deserializer);
+};
+
+// Trait that marks element types whose in-memory representation matches
+// their serialized encoding byte for byte, so that whole sequences of them
+// can be copied in one block instead of element by element. This holds for
+// fixed-width numeric types on little-endian targets. `bool` is excluded
+// because not every byte is a valid `bool` value.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+template <typename T>
+struct is_trivially_serializable
+    : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                       !std::is_same<T, bool>::value> {};
+#else
+template <typename T>
+struct is_trivially_serializable : std::false_type {};
+#endif
+
+// Compile-time layout verification for opting a fixed-size POD struct into
+// the bulk memcpy path. The per-field bincode encoding of such a struct
+// equals its in-memory layout when the struct is standard-layout, every
+// field is a fixed-width scalar and there is no padding. Specialize
+// is_trivially_serializable with the field types listed in declaration
+// order:
+//
+//     template <>
+//     struct serde::is_trivially_serializable<Sample>
+//         : serde::verified_trivial_layout<Sample, int64_t, double> {};
+//
+// after which sequences like std::vector<Sample> are copied in one block
+// instead of element by element. A struct that violates one of the layout
+// requirements is rejected at compile time.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+template <typename T, typename... Fields>
+struct verified_trivial_layout : std::true_type {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "bulk-copied structs must be trivially copyable");
+    static_assert(std::is_standard_layout<T>::value,
+                  "bulk-copied structs must be standard-layout");
+    static_assert((is_trivially_serializable<Fields>::value && ...),
+                  "every field must itself be trivially serializable");
+    static_assert(sizeof(T) == (sizeof(Fields) + ... + size_t(0)),
+                  "the struct must not contain any padding");
+};
+#else
+template <typename T, typename... Fields>
+struct verified_trivial_layout : std::false_type {};
+#endif
+
+// Whether a (de)serializer encodes multi-byte integers at their fixed
+// width. Serializers using a variable-width integer encoding (see
+// BincodeCompactSerializer in bincode.hpp) opt out by declaring
+// `static constexpr bool fixed_int_encoding = false`, which restricts the
+// bulk copy fast path below to single-byte and floating-point elements.
+template <typename S, typename = void>
+struct uses_fixed_int_encoding : std::true_type {};
+
+template <typename S>
+struct uses_fixed_int_encoding<S, std::void_t<decltype(S::fixed_int_encoding)>>
+    : std::integral_constant<bool, S::fixed_int_encoding> {};
+
+// Whether sequences of T may be block-copied through serializer S: T's
+// in-memory layout must match its encoding and S must not varint-encode
+// T's fields.
+template <typename T, typename S>
+struct is_bulk_copy_safe
+    : std::integral_constant<bool,
+                             is_trivially_serializable<T>::value &&
+                                 (uses_fixed_int_encoding<S>::value ||
+                                  sizeof(T) == 1 ||
+                                  std::is_floating_point<T>::value)> {};
+
+// Detect whether a serializer offers the optional `serialize_raw_bytes`
+// extension used by the bulk copy fast path below.
+template <typename Serializer, typename = void>
+struct has_serialize_raw_bytes : std::false_type {};
+
+template <typename Serializer>
+struct has_serialize_raw_bytes<
+    Serializer,
+    std::void_t<decltype(std::declval<Serializer &>().serialize_raw_bytes(
+        std::declval<const uint8_t *>(), std::declval<size_t>()))>>
+    : std::true_type {};
+
+// Detect whether a deserializer offers the matching `deserialize_raw_bytes`
+// extension.
+template <typename Deserializer, typename = void>
+struct has_deserialize_raw_bytes : std::false_type {};
+
+template <typename Deserializer>
+struct has_deserialize_raw_bytes<
+    Deserializer,
+    std::void_t<decltype(std::declval<Deserializer &>().deserialize_raw_bytes(
+        std::declval<uint8_t *>(), std::declval<size_t>()))>>
+    : std::true_type {};
+
+// Detect whether a deserializer carries a polymorphic memory resource that
+// allocator-aware containers should be constructed from.
+template <typename Deserializer, typename = void>
+struct has_memory_resource : std::false_type {};
+
+template <typename Deserializer>
+struct has_memory_resource<
+    Deserializer,
+    std::void_t<
+        decltype(std::declval<Deserializer &>().get_memory_resource())>>
+    : std::true_type {};
+
+// Detect whether `Deserializable<T>` offers the storage-reusing
+// `deserialize_into` member for this deserializer.
+template <typename T, typename Deserializer, typename = void>
+struct has_deserialize_into : std::false_type {};
+
+template <typename T, typename Deserializer>
+struct has_deserialize_into<
+    T, Deserializer,
+    std::void_t<decltype(Deserializable<T>::deserialize_into(
+        std::declval<T &>(), std::declval<Deserializer &>()))>>
+    : std::true_type {};
+
+// Deserializes into an existing object instead of constructing a fresh one,
+// so repeated calls reuse the capacity of strings and vectors the object
+// already holds — e.g. a polling loop receiving structurally identical
+// values reaches zero allocations per iteration in steady state. Types
+// without a dedicated `deserialize_into` fall back to
+// deserialize-and-assign.
+template <typename T, typename Deserializer>
+void deserialize_into(T &out, Deserializer &deserializer) {
+    if constexpr (has_deserialize_into<T, Deserializer>::value) {
+        Deserializable<T>::deserialize_into(out, deserializer);
+    } else {
+        out = Deserializable<T>::deserialize(deserializer);
+    }
+}
+
+// Constructs an empty container of type T. When T uses a polymorphic
+// allocator and the deserializer carries a memory resource, the container is
+// bound to that resource, so a whole response tree can materialize into a
+// single arena (e.g. std::pmr::monotonic_buffer_resource) and be freed in
+// one shot.
+template <typename T, typename Deserializer>
+T make_container(Deserializer &deserializer) {
+    if constexpr (std::uses_allocator<
+                      T, std::pmr::polymorphic_allocator<std::byte>>::value &&
+                  has_memory_resource<Deserializer>::value) {
+        return T(deserializer.get_memory_resource());
+    } else {
+        (void)deserializer;
+        return T();
+    }
+}
+
+// A read-mostly map over a sorted vector. Bincode-encoded BTreeMaps arrive
+// in key order, so building one is a series of appends into contiguous
+// storage, and lookups are cache-friendly binary searches instead of pointer
+// chases through a node-per-entry tree. Mutation is O(n) in the general
+// case: build it once, then query it.
+template <typename K, typename V, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<std::pair<K, V>>>
+class flat_map {
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using storage_type = std::vector<value_type, Allocator>;
+    using const_iterator = typename storage_type::const_iterator;
+    using size_type = typename storage_type::size_type;
+
+    flat_map() = default;
+    explicit flat_map(const Allocator &allocator) : entries_(allocator) {}
+
+    size_type size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    void reserve(size_type capacity) { entries_.reserve(capacity); }
+
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+
+    const_iterator find(const K &key) const {
+        auto it = lower_bound(key);
+        if (it != entries_.end() && !comp_(key, it->first)) {
+            return it;
+        }
+        return entries_.end();
+    }
+
+    size_type count(const K &key) const {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    const V &at(const K &key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("flat_map::at: key not found");
+        }
+        return it->second;
+    }
+
+    // Appending an entry that sorts after everything present is O(1); out
+    // of order input falls back to a positioned insert (overwriting on
+    // duplicate keys), so the map stays valid either way.
+    void insert(value_type entry) {
+        if (entries_.empty() || comp_(entries_.back().first, entry.first)) {
+            entries_.push_back(std::move(entry));
+            return;
+        }
+        auto it = entries_.begin() + (lower_bound(entry.first) - begin());
+        if (it != entries_.end() && !comp_(entry.first, it->first)) {
+            it->second = std::move(entry.second);
+        } else {
+            entries_.insert(it, std::move(entry));
+        }
+    }
+
+    friend bool operator==(const flat_map &lhs, const flat_map &rhs) {
+        return lhs.entries_ == rhs.entries_;
+    }
+
+  private:
+    const_iterator lower_bound(const K &key) const {
+        return std::lower_bound(entries_.begin(), entries_.end(), key,
+                                [this](const value_type &entry, const K &k) {
+                                    return comp_(entry.first, k);
+                                });
+    }
+
+    storage_type entries_;
+    Compare comp_;
+};
+
+// A single-pass range over a serialized sequence that deserializes one
+// element at a time, so consuming a huge result element-wise needs O(1)
+// extra memory instead of materializing the full vector next to the
+// serialized buffer. The stream owns the buffer and hands it back to the
+// BufferPool when destroyed; iterate it once, front to back.
+template <typename T, typename Deserializer>
+class SequenceStream {
+  public:
+    // Takes ownership of `buffer` and reads the sequence starting at
+    // `offset`; the first element is decoded eagerly so `begin()` is cheap.
+    SequenceStream(std::vector<uint8_t> buffer, size_t offset, size_t size)
+        : buffer_(std::move(buffer)),
+          deserializer_(buffer_.data() + offset, size - offset) {
+        remaining_ = deserializer_.deserialize_len();
+        total_ = remaining_;
+        advance();
+    }
+
+    // Copying would duplicate the read cursor; moving is fine because the
+    // vector's heap storage (and with it the deserializer's pointers) stays
+    // put.
+    SequenceStream(const SequenceStream &) = delete;
+    SequenceStream &operator=(const SequenceStream &) = delete;
+    SequenceStream(SequenceStream &&) = default;
+    SequenceStream &operator=(SequenceStream &&) = default;
+
+    ~SequenceStream() {
+        if (buffer_.capacity() != 0) {
+            BufferPool::release(std::move(buffer_));
+        }
+    }
+
+    class iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        reference operator*() const { return *stream_->current_; }
+        pointer operator->() const { return &*stream_->current_; }
+
+        iterator &operator++() {
+            stream_->advance();
+            if (!stream_->current_.has_value()) {
+                stream_ = nullptr;
+            }
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator &lhs, const iterator &rhs) {
+            return lhs.stream_ == rhs.stream_;
+        }
+        friend bool operator!=(const iterator &lhs, const iterator &rhs) {
+            return !(lhs == rhs);
+        }
+
+      private:
+        friend class SequenceStream;
+        explicit iterator(SequenceStream *stream) : stream_(stream) {}
+        SequenceStream *stream_;
+    };
+
+    iterator begin() {
+        return iterator(current_.has_value() ? this : nullptr);
+    }
+    iterator end() { return iterator(nullptr); }
+
+    // Number of elements announced by the sequence header.
+    size_t size() const { return total_; }
+    bool empty() const { return total_ == 0; }
+
+  private:
+    void advance() {
+        if (remaining_ == 0) {
+            current_.reset();
+            return;
+        }
+        remaining_--;
+        current_ = Deserializable<T>::deserialize(deserializer_);
+    }
+
+    std::vector<uint8_t> buffer_;
+    Deserializer deserializer_;
+    size_t remaining_ = 0;
+    size_t total_ = 0;
+    std::optional<T> current_;
+};
+
+// Tags an error value for constructing an `expected` in its error state.
+template <typename E>
+struct unexpected {
+    E value;
+
+    explicit unexpected(E error) : value(std::move(error)) {}
+};
+
+// Minimal stand-in for std::expected (C++23), used by the generated `try_`
+// call variants: holds either a result value or an error, so callers that
+// treat errors as data get a branch instead of a stack unwind.
+template <typename T, typename E>
+class expected {
+  public:
+    expected(T value) : storage_(std::in_place_index<0>, std::move(value)) {}
+    expected(unexpected<E> error)
+        : storage_(std::in_place_index<1>, std::move(error.value)) {}
+
+    bool has_value() const { return storage_.index() == 0; }
+    explicit operator bool() const { return has_value(); }
+
+    T &value() & { return std::get<0>(storage_); }
+    const T &value() const & { return std::get<0>(storage_); }
+    T &&value() && { return std::get<0>(std::move(storage_)); }
+
+    E &error() { return std::get<1>(storage_); }
+    const E &error() const { return std::get<1>(storage_); }
+
+    T &operator*() { return value(); }
+    const T &operator*() const { return value(); }
+    T *operator->() { return &value(); }
+    const T *operator->() const { return &value(); }
+
+  private:
+    std::variant<T, E> storage_;
+};
+
+// void results carry only the possible error.
+template <typename E>
+class expected<void, E> {
+  public:
+    expected() = default;
+    expected(unexpected<E> error) : error_(std::move(error.value)) {}
+
+    bool has_value() const { return !error_.has_value(); }
+    explicit operator bool() const { return has_value(); }
+
+    E &error() { return *error_; }
+    const E &error() const { return *error_; }
+
+  private:
+    std::optional<E> error_;
+};
+
+// Endian-independent readers for the raw little-endian framing used by the
+// chunk-indexed batch encoding.
+inline uint32_t read_le_u32(const uint8_t *data) {
+    return uint32_t(data[0]) | (uint32_t(data[1]) << 8) |
+           (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+inline uint64_t read_le_u64(const uint8_t *data) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+// Safe decoder for the LZ4 block format, which is what the Rust side's
+// `compressed_payloads` feature emits for large responses. Throws
+// `deserialization_error` on malformed input instead of reading or writing
+// out of bounds.
+inline void lz4_decompress_block(const uint8_t *src, size_t src_size,
+                                 uint8_t *dst, size_t dst_size) {
+    const uint8_t *src_end = src + src_size;
+    uint8_t *dst_begin = dst;
+    uint8_t *dst_end = dst + dst_size;
+    while (src < src_end) {
+        const uint8_t token = *src++;
+        size_t literal_len = token >> 4;
+        if (literal_len == 15) {
+            uint8_t byte;
+            do {
+                if (src >= src_end) {
+                    throw deserialization_error("LZ4 block is truncated");
+                }
+                byte = *src++;
+                literal_len += byte;
+            } while (byte == 255);
+        }
+        if (literal_len > size_t(src_end - src) ||
+            literal_len > size_t(dst_end - dst)) {
+            throw deserialization_error("LZ4 block is truncated");
+        }
+        std::memcpy(dst, src, literal_len);
+        src += literal_len;
+        dst += literal_len;
+        if (src == src_end) {
+            break;  // the last sequence consists of literals only
+        }
+        if (src_end - src < 2) {
+            throw deserialization_error("LZ4 block is truncated");
+        }
+        const size_t offset = size_t(src[0]) | (size_t(src[1]) << 8);
+        src += 2;
+        if (offset == 0 || offset > size_t(dst - dst_begin)) {
+            throw deserialization_error("LZ4 match offset is out of range");
+        }
+        size_t match_len = token & 0x0f;
+        if (match_len == 15) {
+            uint8_t byte;
+            do {
+                if (src >= src_end) {
+                    throw deserialization_error("LZ4 block is truncated");
+                }
+                byte = *src++;
+                match_len += byte;
+            } while (byte == 255);
+        }
+        match_len += 4;
+        if (match_len > size_t(dst_end - dst)) {
+            throw deserialization_error("LZ4 block overflows its output");
+        }
+        const uint8_t *match = dst - offset;
+        // byte-wise copy: matches may overlap their own output
+        for (size_t i = 0; i < match_len; ++i) {
+            *dst++ = *match++;
+        }
+    }
+    if (dst != dst_end) {
+        throw deserialization_error("LZ4 block decoded to the wrong size");
+    }
+}
+
+// A decoded response payload: either the original call buffer with the tag
+// byte skipped, or a freshly decompressed buffer starting at offset zero.
+struct PayloadView {
+    std::vector<uint8_t> buffer;
+    size_t offset;
+    size_t size;
+
+    const uint8_t *data() const { return buffer.data() + offset; }
+};
+
+// Undo the framing the Rust side applies under its `compressed_payloads`
+// feature: a leading tag byte of 0 marks a raw bincode payload, 1 marks
+// [raw_len: u64 le][lz4 block]. The uncompressed case is zero-copy; the
+// compressed case releases the call buffer back to the BufferPool.
+inline PayloadView decode_compressed_payload(std::vector<uint8_t> buffer,
+                                             size_t size) {
+    if (size == 0) {
+        throw deserialization_error("Compressed response is truncated");
+    }
+    if (buffer[0] == 0) {
+        return PayloadView{std::move(buffer), 1, size - 1};
+    }
+    if (buffer[0] != 1 || size < 1 + sizeof(uint64_t)) {
+        throw deserialization_error("Compressed response is malformed");
+    }
+    const uint64_t raw_len = read_le_u64(buffer.data() + 1);
+    std::vector<uint8_t> decompressed(static_cast<size_t>(raw_len));
+    lz4_decompress_block(buffer.data() + 1 + sizeof(uint64_t),
+                         size - 1 - sizeof(uint64_t), decompressed.data(),
+                         decompressed.size());
+    BufferPool::release(std::move(buffer));
+    return PayloadView{std::move(decompressed), 0,
+                       static_cast<size_t>(raw_len)};
+}
+
+// Decodes the chunk-indexed sequence framing produced by the macro's
+// `chunked_batch` mode: [count: u64 le][offsets: u64 le * count]
+// [elements...]. The offset table gives every element's byte range, so
+// decoding is no longer forced to walk the buffer sequentially: contiguous
+// element ranges are fanned out across std::async tasks and deserialized
+// concurrently, then moved together in order.
+template <typename T, typename Deserializer>
+std::vector<T> deserialize_chunked_sequence(const uint8_t *data, size_t size) {
+    if (size < sizeof(uint64_t)) {
+        throw deserialization_error("Chunked sequence header is truncated");
+    }
+    uint64_t count = read_le_u64(data);
+    if (count > (size - sizeof(uint64_t)) / sizeof(uint64_t)) {
+        throw deserialization_error("Chunked sequence offset table is truncated");
+    }
+    const uint8_t *elements = data + sizeof(uint64_t) + count * sizeof(uint64_t);
+    const size_t elements_size = size - size_t(elements - data);
+    auto element_range = [&](uint64_t i) {
+        uint64_t begin =
+            read_le_u64(data + sizeof(uint64_t) + i * sizeof(uint64_t));
+        uint64_t end =
+            i + 1 < count
+                ? read_le_u64(data + sizeof(uint64_t) + (i + 1) * sizeof(uint64_t))
+                : elements_size;
+        if (begin > end || end > elements_size) {
+            throw deserialization_error("Chunked sequence offsets are out of range");
+        }
+        return std::pair<uint64_t, uint64_t>(begin, end);
+    };
+    auto decode_range = [&](uint64_t begin_index, uint64_t end_index) {
+        std::vector<T> chunk;
+        chunk.reserve(size_t(end_index - begin_index));
+        for (uint64_t i = begin_index; i < end_index; i++) {
+            auto range = element_range(i);
+            auto deserializer =
+                Deserializer(elements + range.first, range.second - range.first);
+            chunk.push_back(Deserializable<T>::deserialize(deserializer));
+            if (deserializer.get_buffer_offset() < range.second - range.first) {
+                throw deserialization_error("Some input bytes were not read");
+            }
+        }
+        return chunk;
+    };
+    // Below this many elements per task the thread handoff costs more than
+    // the decoding it saves.
+    constexpr uint64_t min_elements_per_task = 256;
+    uint64_t workers = std::thread::hardware_concurrency();
+    workers = std::min(workers, count / min_elements_per_task);
+    if (workers <= 1) {
+        return decode_range(0, count);
+    }
+    std::vector<std::future<std::vector<T>>> tasks;
+    tasks.reserve(size_t(workers));
+    const uint64_t per_task = count / workers;
+    const uint64_t remainder = count % workers;
+    uint64_t begin = 0;
+    for (uint64_t w = 0; w < workers; w++) {
+        uint64_t end = begin + per_task + (w < remainder ? 1 : 0);
+        tasks.push_back(std::async(std::launch::async, decode_range, begin, end));
+        begin = end;
+    }
+    std::vector<T> result;
+    result.reserve(size_t(count));
+    for (auto &task : tasks) {
+        std::vector<T> chunk = task.get();
+        result.insert(result.end(), std::make_move_iterator(chunk.begin()),
+                      std::make_move_iterator(chunk.end()));
+    }
+    return result;
+}
+
+// --- Implementation of Serializable for base types ---
+
+// string
+template <>
+struct Serializable<std::string> {
+    template <typename Serializer>
+    static void serialize(const std::string &value, Serializer &serializer) {
+        serializer.serialize_str(value);
+    }
+};
+
+// read-only string views; lets callers serialize literals or slices of a
+// larger buffer without allocating, and deserialize without copying (the
+// returned view borrows from the deserializer's input buffer and must not
+// outlive it)
+template <>
+struct Serializable<std::string_view> {
+    template <typename Serializer>
+    static void serialize(const std::string_view &value,
+                          Serializer &serializer) {
+        serializer.serialize_str(value);
+    }
+};
+
+// allocator-aware strings (e.g. std::pmr::string); the encoding is identical
+// to std::string
+template <typename CharTraits, typename Allocator>
+struct Serializable<std::basic_string<char, CharTraits, Allocator>> {
+    template <typename Serializer>
+    static void
+    serialize(const std::basic_string<char, CharTraits, Allocator> &value,
+              Serializer &serializer) {
+        serializer.serialize_str(std::string_view(value.data(), value.size()));
+    }
+};
+
+// unit
+template <>
+struct Serializable<std::monostate> {
+    template <typename Serializer>
+    static void serialize(const std::monostate &_value,
+                          Serializer &serializer) {
+        serializer.serialize_unit();
+    }
+};
+
+// bool
+template <>
+struct Serializable<bool> {
+    template <typename Serializer>
+    static void serialize(const bool &value, Serializer &serializer) {
+        serializer.serialize_bool(value);
+    }
+};
+
+// UTF-8 char
+template <>
+struct Serializable<char32_t> {
+    template <typename Serializer>
+    static void serialize(const char32_t &value, Serializer &serializer) {
+        serializer.serialize_char(value);
+    }
+};
+
+// f32
+template <>
+struct Serializable<float> {
+    template <typename Serializer>
+    static void serialize(const float &value, Serializer &serializer) {
+        serializer.serialize_f32(value);
+    }
+};
+
+// f64
+template <>
+struct Serializable<double> {
+    template <typename Serializer>
+    static void serialize(const double &value, Serializer &serializer) {
+        serializer.serialize_f64(value);
+    }
+};
+
+// u8
+template <>
+struct Serializable<uint8_t> {
+    template <typename Serializer>
+    static void serialize(const uint8_t &value, Serializer &serializer) {
+        serializer.serialize_u8(value);
+    }
+};
+
+// u16
+template <>
+struct Serializable<uint16_t> {
+    template <typename Serializer>
+    static void serialize(const uint16_t &value, Serializer &serializer) {
+        serializer.serialize_u16(value);
+    }
+};
+
+// u32
+template <>
+struct Serializable<uint32_t> {
+    template <typename Serializer>
+    static void serialize(const uint32_t &value, Serializer &serializer) {
+        serializer.serialize_u32(value);
+    }
+};
+
+// u64
+template <>
+struct Serializable<uint64_t> {
+    template <typename Serializer>
+    static void serialize(const uint64_t &value, Serializer &serializer) {
+        serializer.serialize_u64(value);
+    }
+};
+
+// u128
+template <>
+struct Serializable<uint128_t> {
+    template <typename Serializer>
+    static void serialize(const uint128_t &value, Serializer &serializer) {
+        serializer.serialize_u128(value);
+    }
+};
+
+// i8
+template <>
+struct Serializable<int8_t> {
+    template <typename Serializer>
+    static void serialize(const int8_t &value, Serializer &serializer) {
+        serializer.serialize_i8(value);
+    }
+};
+
+// i16
+template <>
+struct Serializable<int16_t> {
+    template <typename Serializer>
+    static void serialize(const int16_t &value, Serializer &serializer) {
+        serializer.serialize_i16(value);
+    }
+};
+
+// i32
+template <>
+struct Serializable<int32_t> {
+    template <typename Serializer>
+    static void serialize(const int32_t &value, Serializer &serializer) {
+        serializer.serialize_i32(value);
+    }
+};
+
+// i64
+template <>
+struct Serializable<int64_t> {
+    template <typename Serializer>
+    static void serialize(const int64_t &value, Serializer &serializer) {
+        serializer.serialize_i64(value);
+    }
+};
+
+// i128
+template <>
+struct Serializable<int128_t> {
+    template <typename Serializer>
+    static void serialize(const int128_t &value, Serializer &serializer) {
+        serializer.serialize_i128(value);
+    }
+};
+
+// --- Derivation of Serializable for composite types ---
+
+// Value pointers (non-nullable)
+template <typename T>
+struct Serializable<value_ptr<T>> {
+    template <typename Serializer>
+    static void serialize(const value_ptr<T> &value, Serializer &serializer) {
+        Serializable<T>::serialize(*value, serializer);
+    }
+};
+
+// Copy-on-write pointers share the wire format of `value_ptr`
+template <typename T>
+struct Serializable<cow_ptr<T>> {
+    template <typename Serializer>
+    static void serialize(const cow_ptr<T> &value, Serializer &serializer) {
+        Serializable<T>::serialize(*value, serializer);
+    }
+};
+
+// Options
+template <typename T>
+struct Serializable<std::optional<T>> {
+    template <typename Serializer>
+    static void serialize(const std::optional<T> &option,
+                          Serializer &serializer) {
+        if (option.has_value()) {
+            serializer.serialize_option_tag(true);
+            Serializable<T>::serialize(option.value(), serializer);
+        } else {
+            serializer.serialize_option_tag(false);
+        }
+    }
+};
+
+// Vectors (sequences)
+template <typename T, typename Allocator>
+struct Serializable<std::vector<T, Allocator>> {
+    template <typename Serializer>
+    static void serialize(const std::vector<T, Allocator> &value,
+                          Serializer &serializer) {
+        serializer.serialize_len(value.size());
+        if constexpr (is_bulk_copy_safe<T, Serializer>::value &&
+                      has_serialize_raw_bytes<Serializer>::value) {
+            serializer.serialize_raw_bytes(
+                reinterpret_cast<const uint8_t *>(value.data()),
+                value.size() * sizeof(T));
+        } else {
+            for (const T &item : value) {
+                Serializable<T>::serialize(item, serializer);
+            }
+        }
+    }
+};
+
+// Fixed-size arrays
+template <typename T, std::size_t N>
+struct Serializable<std::array<T, N>> {
+    template <typename Serializer>
+    static void serialize(const std::array<T, N> &value,
+                          Serializer &serializer) {
+        for (const T &item : value) {
+            Serializable<T>::serialize(item, serializer);
+        }
+    }
+};
+
+// Maps
+template <typename K, typename V, typename Compare, typename Allocator>
+struct Serializable<std::map<K, V, Compare, Allocator>> {
+    template <typename Serializer>
+    static void serialize(const std::map<K, V, Compare, Allocator> &value,
+                          Serializer &serializer) {
+        serializer.serialize_len(value.size());
+        std::vector<size_t> offsets;
+        for (const auto &item : value) {
+            if constexpr (Serializer::enforce_strict_map_ordering) {
+                offsets.push_back(serializer.get_buffer_offset());
+            }
+            Serializable<K>::serialize(item.first, serializer);
+            Serializable<V>::serialize(item.second, serializer);
+        }
+        if constexpr (Serializer::enforce_strict_map_ordering) {
+            serializer.sort_last_entries(std::move(offsets));
+        }
+    }
+};
+
+// Flat maps encode exactly like std::map: the entries are already in key
+// order
+template <typename K, typename V, typename Compare, typename Allocator>
+struct Serializable<flat_map<K, V, Compare, Allocator>> {
+    template <typename Serializer>
+    static void serialize(const flat_map<K, V, Compare, Allocator> &value,
+                          Serializer &serializer) {
+        serializer.serialize_len(value.size());
+        std::vector<size_t> offsets;
+        for (const auto &item : value) {
+            if constexpr (Serializer::enforce_strict_map_ordering) {
+                offsets.push_back(serializer.get_buffer_offset());
+            }
+            Serializable<K>::serialize(item.first, serializer);
+            Serializable<V>::serialize(item.second, serializer);
+        }
+        if constexpr (Serializer::enforce_strict_map_ordering) {
+            serializer.sort_last_entries(std::move(offsets));
+        }
+    }
+};
+
+// Tuples
+template <class... Types>
+struct Serializable<std::tuple<Types...>> {
+    template <typename Serializer>
+    static void serialize(const std::tuple<Types...> &value,
+                          Serializer &serializer) {
+        // Visit each of the type components.
+        std::apply(
+            [&serializer](Types const &... args) {
+                (Serializable<Types>::serialize(args, serializer), ...);
+            },
+            value);
+    }
+};
+
+// Enums
+template <class... Types>
+struct Serializable<std::variant<Types...>> {
+    template <typename Serializer>
+    static void serialize(const std::variant<Types...> &value,
+                          Serializer &serializer) {
+        // Write the variant index.
+        serializer.serialize_variant_index(value.index());
+        // Visit the inner type.
+        std::visit(
+            [&serializer](const auto &arg) {
+                using T = typename std::decay<decltype(arg)>::type;
+                Serializable<T>::serialize(arg, serializer);
+            },
+            value);
+    }
+};
+
+// --- Implementation of Deserializable for base types ---
+
+// string
+template <>
+struct Deserializable<std::string> {
+    template <typename Deserializer>
+    static std::string deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_str();
+    }
+
+    // reuses the capacity of `out` instead of allocating a fresh string
+    template <typename Deserializer>
+    static void deserialize_into(std::string &out, Deserializer &deserializer) {
+        out = deserializer.deserialize_str_into(std::move(out));
+    }
+};
+
+// zero-copy strings: the view borrows from the deserializer's input buffer
+// and must not outlive it
+template <>
+struct Deserializable<std::string_view> {
+    template <typename Deserializer>
+    static std::string_view deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_str_view();
+    }
+};
+
+// allocator-aware strings (e.g. std::pmr::string); the content is read
+// directly into storage obtained from the target allocator
+template <typename CharTraits, typename Allocator>
+struct Deserializable<std::basic_string<char, CharTraits, Allocator>> {
+    template <typename Deserializer>
+    static std::basic_string<char, CharTraits, Allocator>
+    deserialize(Deserializer &deserializer) {
+        using Str = std::basic_string<char, CharTraits, Allocator>;
+        return deserializer.deserialize_str_into(
+            make_container<Str>(deserializer));
+    }
+};
+
+// unit
+template <>
+struct Deserializable<std::monostate> {
+    template <typename Deserializer>
+    static std::monostate deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_unit();
+    }
+};
+
+// bool
+template <>
+struct Deserializable<bool> {
+    template <typename Deserializer>
+    static bool deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_bool();
+    }
+};
+
+// f32
+template <>
+struct Deserializable<float> {
+    template <typename Deserializer>
+    static float deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_f32();
+    }
+};
+
+// f64
+template <>
+struct Deserializable<double> {
+    template <typename Deserializer>
+    static double deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_f64();
+    }
+};
+
+// UTF-8 char
+template <>
+struct Deserializable<char32_t> {
+    template <typename Deserializer>
+    static char32_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_char();
+    }
+};
+
+// u8
+template <>
+struct Deserializable<uint8_t> {
+    template <typename Deserializer>
+    static uint8_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_u8();
+    }
+};
+
+// u16
+template <>
+struct Deserializable<uint16_t> {
+    template <typename Deserializer>
+    static uint16_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_u16();
+    }
+};
+
+// u32
+template <>
+struct Deserializable<uint32_t> {
+    template <typename Deserializer>
+    static uint32_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_u32();
+    }
+};
+
+// u64
+template <>
+struct Deserializable<uint64_t> {
+    template <typename Deserializer>
+    static uint64_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_u64();
+    }
+};
+
+// u128
+template <>
+struct Deserializable<uint128_t> {
+    template <typename Deserializer>
+    static uint128_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_u128();
+    }
+};
+
+// i8
+template <>
+struct Deserializable<int8_t> {
+    template <typename Deserializer>
+    static int8_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_i8();
+    }
+};
+
+// i16
+template <>
+struct Deserializable<int16_t> {
+    template <typename Deserializer>
+    static int16_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_i16();
+    }
+};
+
+// i32
+template <>
+struct Deserializable<int32_t> {
+    template <typename Deserializer>
+    static int32_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_i32();
+    }
+};
+
+// i64
+template <>
+struct Deserializable<int64_t> {
+    template <typename Deserializer>
+    static int64_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_i64();
+    }
+};
+
+// i128
+template <>
+struct Deserializable<int128_t> {
+    template <typename Deserializer>
+    static int128_t deserialize(Deserializer &deserializer) {
+        return deserializer.deserialize_i128();
+    }
+};
+
+// --- Derivation of Deserializable for composite types ---
+
+// Value pointers
+template <typename T>
+struct Deserializable<value_ptr<T>> {
+    template <typename Deserializer>
+    static value_ptr<T> deserialize(Deserializer &deserializer) {
+        return value_ptr<T>(Deserializable<T>::deserialize(deserializer));
+    }
+};
+
+// Copy-on-write pointers
+template <typename T>
+struct Deserializable<cow_ptr<T>> {
+    template <typename Deserializer>
+    static cow_ptr<T> deserialize(Deserializer &deserializer) {
+        return cow_ptr<T>(Deserializable<T>::deserialize(deserializer));
+    }
+};
+
+// Options
+template <typename T>
+struct Deserializable<std::optional<T>> {
+    template <typename Deserializer>
+    static std::optional<T> deserialize(Deserializer &deserializer) {
+        auto tag = deserializer.deserialize_option_tag();
+        if (!tag) {
+            return {};
+        } else {
+            return {Deserializable<T>::deserialize(deserializer)};
+        }
+    }
+};
+
+// Vectors
+template <typename T, typename Allocator>
+struct Deserializable<std::vector<T, Allocator>> {
+    template <typename Deserializer>
+    static std::vector<T, Allocator> deserialize(Deserializer &deserializer) {
+        std::vector<T, Allocator> result =
+            make_container<std::vector<T, Allocator>>(deserializer);
+        size_t len = deserializer.deserialize_len();
+        if constexpr (is_bulk_copy_safe<T, Deserializer>::value &&
+                      has_deserialize_raw_bytes<Deserializer>::value) {
+            result.resize(len);
+            deserializer.deserialize_raw_bytes(
+                reinterpret_cast<uint8_t *>(result.data()),
+                len * sizeof(T));
+        } else {
+            for (size_t i = 0; i < len; i++) {
+                result.push_back(Deserializable<T>::deserialize(deserializer));
+            }
+        }
+        return result;
+    }
+
+    // reuses the vector's capacity and, element-wise, the storage of the
+    // elements it already holds
+    template <typename Deserializer>
+    static void deserialize_into(std::vector<T, Allocator> &out,
+                                 Deserializer &deserializer) {
+        size_t len = deserializer.deserialize_len();
+        if constexpr (is_bulk_copy_safe<T, Deserializer>::value &&
+                      has_deserialize_raw_bytes<Deserializer>::value) {
+            out.resize(len);
+            deserializer.deserialize_raw_bytes(
+                reinterpret_cast<uint8_t *>(out.data()),
+                len * sizeof(T));
+        } else {
+            size_t reused = std::min(len, out.size());
+            out.resize(reused);
+            for (size_t i = 0; i < reused; i++) {
+                serde::deserialize_into(out[i], deserializer);
+            }
+            for (size_t i = reused; i < len; i++) {
+                out.push_back(Deserializable<T>::deserialize(deserializer));
+            }
+        }
+    }
+};
+
+// Maps
+template <typename K, typename V, typename Compare, typename Allocator>
+struct Deserializable<std::map<K, V, Compare, Allocator>> {
+    template <typename Deserializer>
+    static std::map<K, V, Compare, Allocator>
+    deserialize(Deserializer &deserializer) {
+        std::map<K, V, Compare, Allocator> result =
+            make_container<std::map<K, V, Compare, Allocator>>(deserializer);
+        size_t len = deserializer.deserialize_len();
+        std::optional<std::tuple<size_t, size_t>> previous_key_slice;
+        for (size_t i = 0; i < len; i++) {
+            if constexpr (Deserializer::enforce_strict_map_ordering) {
+                auto start = deserializer.get_buffer_offset();
+                auto key = Deserializable<K>::deserialize(deserializer);
+                auto end = deserializer.get_buffer_offset();
+                if (previous_key_slice.has_value()) {
+                    deserializer.check_that_key_slices_are_increasing(
+                        previous_key_slice.value(), {start, end});
+                }
+                previous_key_slice = {start, end};
+                auto value = Deserializable<V>::deserialize(deserializer);
+                // the encoding is sorted by key, so hinting at end() makes
+                // each insert amortized O(1) instead of a tree search
+                result.emplace_hint(result.end(), std::move(key),
+                                    std::move(value));
+            } else {
+                auto key = Deserializable<K>::deserialize(deserializer);
+                auto value = Deserializable<V>::deserialize(deserializer);
+                result.emplace_hint(result.end(), std::move(key),
+                                    std::move(value));
+            }
+        }
+        return result;
+    }
+};
+
+// Flat maps
+template <typename K, typename V, typename Compare, typename Allocator>
+struct Deserializable<flat_map<K, V, Compare, Allocator>> {
+    template <typename Deserializer>
+    static flat_map<K, V, Compare, Allocator>
+    deserialize(Deserializer &deserializer) {
+        flat_map<K, V, Compare, Allocator> result =
+            make_container<flat_map<K, V, Compare, Allocator>>(deserializer);
+        size_t len = deserializer.deserialize_len();
+        result.reserve(len);
+        std::optional<std::tuple<size_t, size_t>> previous_key_slice;
+        for (size_t i = 0; i < len; i++) {
+            if constexpr (Deserializer::enforce_strict_map_ordering) {
+                auto start = deserializer.get_buffer_offset();
+                auto key = Deserializable<K>::deserialize(deserializer);
+                auto end = deserializer.get_buffer_offset();
+                if (previous_key_slice.has_value()) {
+                    deserializer.check_that_key_slices_are_increasing(
+                        previous_key_slice.value(), {start, end});
+                }
+                previous_key_slice = {start, end};
+                auto value = Deserializable<V>::deserialize(deserializer);
+                result.insert({std::move(key), std::move(value)});
+            } else {
+                auto key = Deserializable<K>::deserialize(deserializer);
+                auto value = Deserializable<V>::deserialize(deserializer);
+                result.insert({std::move(key), std::move(value)});
+            }
+        }
+        return result;
+    }
+};
+
+// Fixed-size arrays
+template <typename T, std::size_t N>
+struct Deserializable<std::array<T, N>> {
+    template <typename Deserializer>
+    static std::array<T, N> deserialize(Deserializer &deserializer) {
+        std::array<T, N> result;
+        for (T &item : result) {
+            item = Deserializable<T>::deserialize(deserializer);
+        }
+        return result;
+    }
+};
+
+// Tuples
+template <class... Types>
+struct Deserializable<std::tuple<Types...>> {
+    template <typename Deserializer>
+    static std::tuple<Types...> deserialize(Deserializer &deserializer) {
+        // Visit each of the type components. We use the constructor of `std::tuple` so
+        // that the evaluation order of arguments is specified by the C++ standard.
+        return std::tuple<Types...>{
+            Deserializable<Types>::deserialize(deserializer)...
+        };
+    }
+};
+
+// Enums
+template <class... Types>
+struct Deserializable<std::variant<Types...>> {
+    template <typename Deserializer>
+    static std::variant<Types...> deserialize(Deserializer &deserializer) {
+        // A "case" is analog to a particular branch in switch-case over the
+        // index. Given the variant type `T` known statically, each case
+        // deserializes a value `T` and returns it as a variant. Plain
+        // function pointers (instead of type-erased std::function) keep the
+        // per-variant deserialization visible to the inliner.
+        using Case = std::variant<Types...> (*)(Deserializer &);
+
+        // The static array of all the cases for this variant.
+        static constexpr std::array<Case, sizeof...(Types)> cases = {
+            +[](Deserializer &de) {
+                return std::variant<Types...>(
+                    Deserializable<Types>::deserialize(de));
+            }...};
+
+        // Read the variant index and execute the corresponding case.
+        auto index = deserializer.deserialize_variant_index();
+        if (index >= cases.size()) {
+            throw deserialization_error("Unknown variant index for enum");
+        }
+        return cases[index](deserializer);
+    }
+};
+
+} // end of namespace serde
@@ -37,6 +37,8 @@ use std::process::{Output, Stdio};
 pub use self::traits::SafeTypeMapping;
 pub use bincode;
 pub use buffi_macro::*;
+#[cfg(feature = "compressed_payloads")]
+pub use lz4_flex;
 
 mod traits;
 
@@ -44,6 +46,14 @@ mod buffi_annotation_attributes;
 
 const FUNCTION_PREFIX: &str = "buffi";
 
+// BuFFI ships its own copy of the C++ serde/bincode runtime. These files
+// started out as the runtime installed by `serde-generate`, but contain
+// additional performance related extensions, so we cannot use
+// `Installer::install_serde_runtime`/`install_bincode_runtime` anymore.
+const SERDE_RUNTIME: &str = include_str!("../runtime/serde.hpp");
+const BINARY_RUNTIME: &str = include_str!("../runtime/binary.hpp");
+const BINCODE_RUNTIME: &str = include_str!("../runtime/bincode.hpp");
+
 type FieldList = Vec<(
     String,
     Vec<(
@@ -78,6 +88,47 @@ pub struct Config {
     pub crate_feature_flags: Option<Vec<String>>,
     /// Add some additional rustdoc flags here, can be useful for debugging
     pub rustdoc_flags: Option<Vec<String>>,
+    /// Emit wrappers that use bincode's variable-width integer encoding
+    /// instead of the legacy fixed-width one; requires the `varint_encoding`
+    /// feature of `buffi_macro` on the Rust side so that both sides agree
+    #[serde(default)]
+    pub varint_encoding: bool,
+    /// Emit map-typed struct fields as `serde::flat_map` (a sorted
+    /// `std::vector` with binary-search lookup) instead of `std::map`;
+    /// worthwhile for large, read-mostly maps
+    #[serde(default)]
+    pub flat_maps: bool,
+    /// Emit recursive struct fields as `serde::cow_ptr` (copy-on-write)
+    /// instead of the deep-copying `serde::value_ptr`; copying a value with
+    /// a long recursive chain then costs one reference bump instead of one
+    /// allocation per node
+    #[serde(default)]
+    pub cow_value_ptr: bool,
+    /// Functions that should additionally get a `{name}_stream` wrapper
+    /// returning a lazily deserializing `serde::SequenceStream` over the
+    /// result sequence instead of a fully materialized vector; only applies
+    /// to functions whose (unwrapped) result is a `Vec`
+    #[serde(default)]
+    pub streaming_functions: Option<Vec<String>>,
+    /// Emit batch wrappers that expect the chunk-indexed batch encoding and
+    /// deserialize result elements concurrently; requires the
+    /// `chunked_batch` feature of `buffi_macro` on the Rust side so that
+    /// both sides agree
+    #[serde(default)]
+    pub chunked_batch: bool,
+    /// Expect `_into` responses framed with a tag byte and LZ4-compress
+    /// large payloads on the Rust side; the wrappers decompress before
+    /// deserializing. Requires the `compressed_payloads` feature of
+    /// `buffi_macro` on the Rust side so that both sides agree
+    #[serde(default)]
+    pub compressed_payloads: bool,
+    /// Additionally emit `{namespace}_extern_templates.hpp`/`.cpp` with
+    /// explicit instantiations of the `Serializable`/`Deserializable`
+    /// machinery for every generated type; translation units that include
+    /// the header skip re-instantiating those templates, which cuts client
+    /// build times for large APIs
+    #[serde(default)]
+    pub extern_templates: bool,
 }
 
 impl Config {
@@ -98,6 +149,13 @@ impl Config {
             generated_by_header: None,
             crate_feature_flags: None,
             rustdoc_flags: None,
+            varint_encoding: false,
+            flat_maps: false,
+            cow_value_ptr: false,
+            streaming_functions: None,
+            chunked_batch: false,
+            compressed_payloads: false,
+            extern_templates: false,
         }
     }
 
@@ -526,6 +584,12 @@ fn generate_function_definitions(
                 out_dir.join(format!("{file_prefix}_{}.hpp", name.to_ascii_lowercase()));
             let mut writer = BufWriter::new(File::create(type_header).unwrap());
             write_function_header(&mut writer, config);
+            writeln!(writer, "#include <atomic>").unwrap();
+            writeln!(writer, "#include <functional>").unwrap();
+            writeln!(writer, "#include <future>").unwrap();
+            writeln!(writer, "#include <map>").unwrap();
+            writeln!(writer, "#include <mutex>").unwrap();
+            writeln!(writer, "#include <string_view>").unwrap();
             writeln!(writer, "#include \"{file_prefix}_api_functions.hpp\"\n").unwrap();
             writeln!(writer, "#include \"{namespace}.hpp\"\n").unwrap();
 
@@ -553,6 +617,7 @@ fn generate_function_definitions(
                 }
             }
             writeln!(writer, "}};\n").unwrap();
+            write_holder_pool(&mut writer, name);
             writeln!(writer, "}}  // end of namespace {namespace}").unwrap();
             writer.flush().unwrap();
         }
@@ -564,6 +629,8 @@ fn generate_function_definitions(
         BufWriter::new(File::create(free_standing_function_header).unwrap());
 
     write_function_header(&mut free_standing_function_header, config);
+    writeln!(free_standing_function_header, "#include <future>").unwrap();
+    writeln!(free_standing_function_header, "#include <string_view>").unwrap();
     writeln!(
         free_standing_function_header,
         "#include \"{file_prefix}_api_functions.hpp\"\n"
@@ -629,6 +696,22 @@ fn generate_function_def(
     config: &Config,
     impl_type: Option<&rustdoc_types::Type>,
 ) {
+    let (serializer_type, deserializer_type) = if config.varint_encoding {
+        (
+            "serde::BincodeCompactSerializer",
+            "serde::BincodeCompactDeserializer",
+        )
+    } else {
+        ("serde::BincodeSerializer", "serde::BincodeDeserializer")
+    };
+    // names used when reading the response; with compressed payloads the
+    // framed call buffer is decoded via `serde::decode_compressed_payload`
+    // before the deserializer is constructed over it
+    let (payload_data, payload_len, payload_buffer) = if config.compressed_payloads {
+        ("payload.data()", "payload.size", "payload.buffer")
+    } else {
+        ("result_buffer.data()", "res_size", "result_buffer")
+    };
     let output_type = if let Some(ref tpe) = m.sig.output {
         let tpe = to_serde_reflect_type(
             tpe,
@@ -706,6 +789,240 @@ fn generate_function_def(
         }
         _ => Cow::Borrowed(&output_type as &str),
     };
+    let unwraps_result = matches!(m.sig.output, Some(rustdoc_types::Type::ResolvedPath(ref p)) if get_name_without_path(&p.path) == "Result");
+    // serialized argument byte total handed to the instrumentation hook; the
+    // argument buffers are released right after the call, so the sum is
+    // captured in a hook-gated local before crossing the boundary
+    let instrument_arg_bytes = {
+        let parts = inputs
+            .iter()
+            .filter(|(n, _)| *n != "self")
+            .map(|(n, tpe)| {
+                if !config.varint_encoding && scalar_encoded_size(tpe).is_some() {
+                    format!("serializer_{n}.size()")
+                } else {
+                    format!("{n}_serialized.size()")
+                }
+            })
+            .collect::<Vec<_>>();
+        if parts.is_empty() {
+            "size_t(0)".to_owned()
+        } else {
+            parts.join(" + ")
+        }
+    };
+    // Non-throwing variant for `Result`-returning functions: the Err branch is
+    // handed back as a value to branch on instead of an exception to unwind,
+    // which matters on call paths where errors are frequent
+    if unwraps_result {
+        let name = item.name.as_deref().unwrap();
+        writeln!(
+            out_functions,
+            "    // Non-throwing variant of `{name}`: an Err response is returned as a value"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "    // instead of being thrown; protocol-level failures still throw"
+        )
+        .unwrap();
+        write!(
+            out_functions,
+            "    inline serde::expected<{return_output_type}, SerializableError> try_{name}("
+        )
+        .unwrap();
+        for (idx, (arg_name, tpe)) in inputs.iter().filter(|(n, _)| *n != "self").enumerate() {
+            if idx != 0 {
+                write!(out_functions, ", ").unwrap();
+            }
+            if tpe == "std::string" {
+                write!(out_functions, "std::string_view {arg_name}").unwrap();
+            } else {
+                write!(out_functions, "const {tpe}& {arg_name}").unwrap();
+            }
+        }
+        writeln!(out_functions, ") {{").unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);"
+        )
+        .unwrap();
+        for (arg_name, tpe) in &inputs {
+            if *arg_name == "self" {
+                continue;
+            }
+            let tpe = if tpe == "std::string" {
+                "std::string_view"
+            } else {
+                tpe.as_str()
+            };
+            // fixed-width scalars have a static encoded size bound, so their
+            // bytes can live on the stack and be handed to the FFI call in
+            // place, keeping the argument path allocation-free
+            if let (false, Some(bound)) = (config.varint_encoding, scalar_encoded_size(tpe)) {
+                writeln!(
+                    out_functions,
+                    "        auto serializer_{arg_name} = serde::SmallBincodeSerializer<{bound}>();"
+                )
+                .unwrap();
+                writeln!(
+                    out_functions,
+                    "        serde::Serializable<{tpe}>::serialize({arg_name}, serializer_{arg_name});"
+                )
+                .unwrap();
+                continue;
+            }
+            writeln!(
+                out_functions,
+                "        auto serializer_{arg_name} = {serializer_type}(serde::BufferPool::acquire());"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        serializer_{arg_name}.reserve(serde::serialized_size({arg_name}));"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        serde::Serializable<{tpe}>::serialize({arg_name}, serializer_{arg_name});"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        std::vector<uint8_t> {arg_name}_serialized = std::move(serializer_{arg_name}).bytes();"
+            )
+            .unwrap();
+        }
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, {instrument_arg_bytes});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();"
+        )
+        .unwrap();
+        writeln!(out_functions).unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);"
+        )
+        .unwrap();
+        write!(
+            out_functions,
+            "        size_t res_size = {prefix}_{name}_into("
+        )
+        .unwrap();
+        for (arg_name, tpe) in inputs.iter() {
+            if *arg_name == "self" {
+                write!(out_functions, "this->inner, ").unwrap();
+            } else if !config.varint_encoding && scalar_encoded_size(tpe).is_some() {
+                write!(
+                    out_functions,
+                    "serializer_{arg_name}.data(), serializer_{arg_name}.size(), "
+                )
+                .unwrap();
+            } else {
+                write!(
+                    out_functions,
+                    "{arg_name}_serialized.data(), {arg_name}_serialized.size(), "
+                )
+                .unwrap();
+            }
+        }
+        writeln!(
+            out_functions,
+            "&result_buffer, [](void* ctx, size_t len) -> uint8_t* {{ try {{ auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); }} catch (...) {{ return nullptr; }} }});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);"
+        )
+        .unwrap();
+        for (arg_name, tpe) in inputs.iter() {
+            if *arg_name == "self"
+                || (!config.varint_encoding && scalar_encoded_size(tpe).is_some())
+            {
+                continue;
+            }
+            writeln!(
+                out_functions,
+                "        serde::BufferPool::release(std::move({arg_name}_serialized));"
+            )
+            .unwrap();
+        }
+        writeln!(out_functions).unwrap();
+        if config.compressed_payloads {
+            writeln!(out_functions, "        auto payload = serde::decode_compressed_payload(std::move(result_buffer), res_size);").unwrap();
+        }
+        writeln!(
+            out_functions,
+            "        auto deserializer = {deserializer_type}({payload_data}, {payload_len});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        {output_type} out = serde::Deserializable<{output_type}>::deserialize(deserializer);"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        if (deserializer.get_buffer_offset() < {payload_len}) {{"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "            throw serde::deserialization_error(\"Some input bytes were not read\");"
+        )
+        .unwrap();
+        writeln!(out_functions, "        }}").unwrap();
+        writeln!(
+            out_functions,
+            "        serde::BufferPool::release(std::move({payload_buffer}));"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);"
+        )
+        .unwrap();
+        writeln!(out_functions, "        BUFFI_INSTRUMENT_CALL(\"{name}\", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);").unwrap();
+        writeln!(out_functions).unwrap();
+        writeln!(
+            out_functions,
+            "        if (out.value.index() == 0) {{ // Ok"
+        )
+        .unwrap();
+        if return_output_type == "void" {
+            writeln!(out_functions, "            return {{}};").unwrap();
+        } else {
+            writeln!(
+                out_functions,
+                "            auto ok = std::get<0>(std::move(out.value));"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "            return std::get<0>(std::move(ok.value));"
+            )
+            .unwrap();
+        }
+        writeln!(out_functions, "        }} else {{ // Err").unwrap();
+        writeln!(
+            out_functions,
+            "            auto err = std::get<1>(std::move(out.value));"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));"
+        )
+        .unwrap();
+        writeln!(out_functions, "        }}").unwrap();
+        writeln!(out_functions, "    }}\n").unwrap();
+    }
     if let Some(ref docs) = item.docs {
         for line in docs.lines() {
             writeln!(out_functions, "    // {line}").unwrap()
@@ -721,98 +1038,840 @@ fn generate_function_def(
         if idx != 0 {
             write!(out_functions, ", ").unwrap();
         }
-        write!(out_functions, "const {tpe}& {name}").unwrap();
+        // strings are taken as views so callers can pass literals or slices
+        // of a larger buffer without allocating a temporary std::string
+        if tpe == "std::string" {
+            write!(out_functions, "std::string_view {name}").unwrap();
+        } else {
+            write!(out_functions, "const {tpe}& {name}").unwrap();
+        }
     }
     writeln!(out_functions, ") {{").unwrap();
-    for (name, tpe) in &inputs {
-        if *name == "self" {
-            continue;
+    if unwraps_result {
+        // the throwing wrapper is a thin shim over the `try_` variant so the
+        // call path exists only once in the generated header
+        let name = item.name.as_deref().unwrap();
+        let arg_names = inputs
+            .iter()
+            .filter(|(n, _)| *n != "self")
+            .map(|(n, _)| n.as_str())
+            .collect::<Vec<_>>()
+            .join(", ");
+        writeln!(
+            out_functions,
+            "        auto result = try_{name}({arg_names});"
+        )
+        .unwrap();
+        writeln!(out_functions, "        if (!result) {{").unwrap();
+        writeln!(out_functions, "            throw result.error();").unwrap();
+        writeln!(out_functions, "        }}").unwrap();
+        if return_output_type != "void" {
+            writeln!(out_functions, "        return std::move(result).value();").unwrap();
+        }
+    } else {
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);"
+        )
+        .unwrap();
+        for (name, tpe) in &inputs {
+            if *name == "self" {
+                continue;
+            }
+            let tpe = if tpe == "std::string" {
+                "std::string_view"
+            } else {
+                tpe.as_str()
+            };
+            // fixed-width scalars have a static encoded size bound, so their
+            // bytes can live on the stack and be handed to the FFI call in
+            // place, keeping the argument path allocation-free
+            if let (false, Some(bound)) = (config.varint_encoding, scalar_encoded_size(tpe)) {
+                writeln!(
+                    out_functions,
+                    "        auto serializer_{name} = serde::SmallBincodeSerializer<{bound}>();"
+                )
+                .unwrap();
+                writeln!(
+                    out_functions,
+                    "        serde::Serializable<{tpe}>::serialize({name}, serializer_{name});"
+                )
+                .unwrap();
+                continue;
+            }
+            writeln!(
+                out_functions,
+                "        auto serializer_{name} = {serializer_type}(serde::BufferPool::acquire());"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        serializer_{name}.reserve(serde::serialized_size({name}));"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        serde::Serializable<{tpe}>::serialize({name}, serializer_{name});"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        std::vector<uint8_t> {name}_serialized = std::move(serializer_{name}).bytes();"
+            )
+            .unwrap();
+        }
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, {instrument_arg_bytes});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();"
+        )
+        .unwrap();
+        writeln!(out_functions).unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);"
+        )
+        .unwrap();
+        write!(
+            out_functions,
+            "        size_t res_size = {}_{}_into(",
+            prefix,
+            item.name.as_deref().unwrap(),
+        )
+        .unwrap();
+        for (name, tpe) in inputs.iter() {
+            if *name == "self" {
+                write!(out_functions, "this->inner, ").unwrap();
+            } else if !config.varint_encoding && scalar_encoded_size(tpe).is_some() {
+                write!(
+                    out_functions,
+                    "serializer_{name}.data(), serializer_{name}.size(), "
+                )
+                .unwrap();
+            } else {
+                write!(
+                    out_functions,
+                    "{name}_serialized.data(), {name}_serialized.size(), "
+                )
+                .unwrap();
+            }
+        }
+        writeln!(
+            out_functions,
+            "&result_buffer, [](void* ctx, size_t len) -> uint8_t* {{ try {{ auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); }} catch (...) {{ return nullptr; }} }});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);"
+        )
+        .unwrap();
+        for (name, tpe) in inputs.iter() {
+            if *name == "self" || (!config.varint_encoding && scalar_encoded_size(tpe).is_some()) {
+                continue;
+            }
+            writeln!(
+                out_functions,
+                "        serde::BufferPool::release(std::move({name}_serialized));"
+            )
+            .unwrap();
+        }
+        writeln!(out_functions).unwrap();
+        if config.compressed_payloads {
+            writeln!(out_functions, "        auto payload = serde::decode_compressed_payload(std::move(result_buffer), res_size);").unwrap();
+        }
+        writeln!(
+            out_functions,
+            "        auto deserializer = {deserializer_type}({payload_data}, {payload_len});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        {output_type} out = serde::Deserializable<{output_type}>::deserialize(deserializer);"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        if (deserializer.get_buffer_offset() < {payload_len}) {{"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "            throw serde::deserialization_error(\"Some input bytes were not read\");"
+        )
+        .unwrap();
+        writeln!(out_functions, "        }}").unwrap();
+        writeln!(
+            out_functions,
+            "        serde::BufferPool::release(std::move({payload_buffer}));"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);"
+        )
+        .unwrap();
+        writeln!(out_functions, "        BUFFI_INSTRUMENT_CALL(\"{}\", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);", item.name.as_deref().unwrap()).unwrap();
+        writeln!(out_functions).unwrap();
+        writeln!(out_functions, "        return out;").unwrap();
+    }
+    writeln!(out_functions, "    }}\n").unwrap();
+
+    // Overloads taking arguments pre-serialized at compile time via
+    // `serde::preserialize`, so call sites with constant arguments do no
+    // serialization work at runtime. The blobs use the fixed-width encoding,
+    // so the overloads are skipped when varint encoding is enabled
+    if !config.varint_encoding && inputs.iter().any(|(n, _)| *n != "self") {
+        let name = item.name.as_deref().unwrap();
+        let non_self_args = inputs
+            .iter()
+            .filter(|(n, _)| *n != "self")
+            .map(|(n, _)| n.as_str())
+            .collect::<Vec<_>>();
+        let template_params = non_self_args
+            .iter()
+            .enumerate()
+            .map(|(idx, _)| format!("size_t N{idx}"))
+            .collect::<Vec<_>>()
+            .join(", ");
+        let params = non_self_args
+            .iter()
+            .enumerate()
+            .map(|(idx, arg_name)| format!("const serde::preserialized<N{idx}>& {arg_name}"))
+            .collect::<Vec<_>>()
+            .join(", ");
+        let arg_bytes = non_self_args
+            .iter()
+            .map(|arg_name| format!("{arg_name}.size()"))
+            .collect::<Vec<_>>()
+            .join(" + ");
+        let call_args = inputs
+            .iter()
+            .map(|(arg_name, _)| {
+                if arg_name.as_str() == "self" {
+                    "this->inner, ".to_owned()
+                } else {
+                    format!("{arg_name}.data(), {arg_name}.size(), ")
+                }
+            })
+            .collect::<String>();
+        writeln!(
+            out_functions,
+            "    // `{name}` overload taking arguments pre-serialized at compile time via"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "    // `serde::preserialize`; constant arguments skip runtime serialization"
+        )
+        .unwrap();
+        writeln!(out_functions, "    template <{template_params}>").unwrap();
+        if unwraps_result {
+            writeln!(
+                out_functions,
+                "    inline serde::expected<{return_output_type}, SerializableError> try_{name}({params}) {{"
+            )
+            .unwrap();
+        } else {
+            writeln!(
+                out_functions,
+                "    inline {return_output_type} {name}({params}) {{"
+            )
+            .unwrap();
+        }
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, {arg_bytes});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();"
+        )
+        .unwrap();
+        writeln!(out_functions).unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        size_t res_size = {prefix}_{name}_into({call_args}&result_buffer, [](void* ctx, size_t len) -> uint8_t* {{ try {{ auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); }} catch (...) {{ return nullptr; }} }});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);"
+        )
+        .unwrap();
+        writeln!(out_functions).unwrap();
+        if config.compressed_payloads {
+            writeln!(out_functions, "        auto payload = serde::decode_compressed_payload(std::move(result_buffer), res_size);").unwrap();
+        }
+        writeln!(
+            out_functions,
+            "        auto deserializer = {deserializer_type}({payload_data}, {payload_len});"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        {output_type} out = serde::Deserializable<{output_type}>::deserialize(deserializer);"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        if (deserializer.get_buffer_offset() < {payload_len}) {{"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "            throw serde::deserialization_error(\"Some input bytes were not read\");"
+        )
+        .unwrap();
+        writeln!(out_functions, "        }}").unwrap();
+        writeln!(
+            out_functions,
+            "        serde::BufferPool::release(std::move({payload_buffer}));"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);"
+        )
+        .unwrap();
+        writeln!(out_functions, "        BUFFI_INSTRUMENT_CALL(\"{name}\", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);").unwrap();
+        writeln!(out_functions).unwrap();
+        if unwraps_result {
+            writeln!(
+                out_functions,
+                "        if (out.value.index() == 0) {{ // Ok"
+            )
+            .unwrap();
+            if return_output_type == "void" {
+                writeln!(out_functions, "            return {{}};").unwrap();
+            } else {
+                writeln!(
+                    out_functions,
+                    "            auto ok = std::get<0>(std::move(out.value));"
+                )
+                .unwrap();
+                writeln!(
+                    out_functions,
+                    "            return std::get<0>(std::move(ok.value));"
+                )
+                .unwrap();
+            }
+            writeln!(out_functions, "        }} else {{ // Err").unwrap();
+            writeln!(
+                out_functions,
+                "            auto err = std::get<1>(std::move(out.value));"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));"
+            )
+            .unwrap();
+            writeln!(out_functions, "        }}").unwrap();
+            writeln!(out_functions, "    }}\n").unwrap();
+            // throwing shim over the pre-serialized `try_` overload, mirroring
+            // the relationship between the plain and `try_` wrappers above
+            writeln!(
+                out_functions,
+                "    // Pre-serialized overload of `{name}`; see `serde::preserialize`"
+            )
+            .unwrap();
+            writeln!(out_functions, "    template <{template_params}>").unwrap();
+            writeln!(
+                out_functions,
+                "    inline {return_output_type} {name}({params}) {{"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        auto result = try_{name}({});",
+                non_self_args.join(", ")
+            )
+            .unwrap();
+            writeln!(out_functions, "        if (!result) {{").unwrap();
+            writeln!(out_functions, "            throw result.error();").unwrap();
+            writeln!(out_functions, "        }}").unwrap();
+            if return_output_type != "void" {
+                writeln!(out_functions, "        return std::move(result).value();").unwrap();
+            }
+            writeln!(out_functions, "    }}\n").unwrap();
+        } else {
+            writeln!(out_functions, "        return out;").unwrap();
+            writeln!(out_functions, "    }}\n").unwrap();
+        }
+    }
+
+    // Non-blocking variant for async Rust functions: run the blocking wrapper
+    // on a background thread so the caller can overlap the Rust work with
+    // other computation instead of stalling on the FFI call
+    if m.header.is_async {
+        let name = item.name.as_deref().unwrap();
+        writeln!(
+            out_functions,
+            "    // Non-blocking variant of `{name}` that runs the call on a background thread"
+        )
+        .unwrap();
+        write!(
+            out_functions,
+            "    inline std::future<{return_output_type}> {name}_async("
+        )
+        .unwrap();
+        for (idx, (arg_name, tpe)) in inputs.iter().filter(|(n, _)| *n != "self").enumerate() {
+            if idx != 0 {
+                write!(out_functions, ", ").unwrap();
+            }
+            write!(out_functions, "const {tpe}& {arg_name}").unwrap();
+        }
+        writeln!(out_functions, ") {{").unwrap();
+        let mut captures = Vec::new();
+        if impl_type.is_some() {
+            captures.push("this");
+        }
+        captures.extend(
+            inputs
+                .iter()
+                .filter(|(n, _)| *n != "self")
+                .map(|(n, _)| n.as_str()),
+        );
+        let arg_names = inputs
+            .iter()
+            .filter(|(n, _)| *n != "self")
+            .map(|(n, _)| n.as_str())
+            .collect::<Vec<_>>()
+            .join(", ");
+        let call_prefix = if impl_type.is_some() { "this->" } else { "" };
+        writeln!(
+            out_functions,
+            "        return std::async(std::launch::async, [{}]() {{ return {call_prefix}{name}({arg_names}); }});",
+            captures.join(", ")
+        )
+        .unwrap();
+        writeln!(out_functions, "    }}\n").unwrap();
+    }
+
+    // Streaming variant: opted in per function via `Config::streaming_functions`
+    // and only meaningful for sequence results; consumers iterate the
+    // serialized buffer directly instead of materializing the full vector
+    let stream_name = item.name.as_deref().unwrap();
+    let wants_stream = config
+        .streaming_functions
+        .as_ref()
+        .is_some_and(|functions| functions.iter().any(|f| f == stream_name));
+    if wants_stream && return_output_type.starts_with("std::vector<") {
+        let element_type = return_output_type
+            .strip_prefix("std::vector<")
+            .and_then(|s| s.strip_suffix('>'))
+            .unwrap();
+        let stream_type = format!("serde::SequenceStream<{element_type}, {deserializer_type}>");
+        writeln!(
+            out_functions,
+            "    // Streaming variant of `{stream_name}`: returns a single-pass range that"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "    // deserializes the result sequence one element at a time instead of"
+        )
+        .unwrap();
+        writeln!(out_functions, "    // materializing the full vector").unwrap();
+        write!(
+            out_functions,
+            "    inline {stream_type} {stream_name}_stream("
+        )
+        .unwrap();
+        for (idx, (arg_name, tpe)) in inputs.iter().filter(|(n, _)| *n != "self").enumerate() {
+            if idx != 0 {
+                write!(out_functions, ", ").unwrap();
+            }
+            if tpe == "std::string" {
+                write!(out_functions, "std::string_view {arg_name}").unwrap();
+            } else {
+                write!(out_functions, "const {tpe}& {arg_name}").unwrap();
+            }
+        }
+        writeln!(out_functions, ") {{").unwrap();
+        for (arg_name, tpe) in &inputs {
+            if *arg_name == "self" {
+                continue;
+            }
+            let tpe = if tpe == "std::string" {
+                "std::string_view"
+            } else {
+                tpe.as_str()
+            };
+            // fixed-width scalars have a static encoded size bound, so their
+            // bytes can live on the stack and be handed to the FFI call in
+            // place, keeping the argument path allocation-free
+            if let (false, Some(bound)) = (config.varint_encoding, scalar_encoded_size(tpe)) {
+                writeln!(
+                    out_functions,
+                    "        auto serializer_{arg_name} = serde::SmallBincodeSerializer<{bound}>();"
+                )
+                .unwrap();
+                writeln!(
+                    out_functions,
+                    "        serde::Serializable<{tpe}>::serialize({arg_name}, serializer_{arg_name});"
+                )
+                .unwrap();
+                continue;
+            }
+            writeln!(
+                out_functions,
+                "        auto serializer_{arg_name} = {serializer_type}(serde::BufferPool::acquire());"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        serializer_{arg_name}.reserve(serde::serialized_size({arg_name}));"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        serde::Serializable<{tpe}>::serialize({arg_name}, serializer_{arg_name});"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "        std::vector<uint8_t> {arg_name}_serialized = std::move(serializer_{arg_name}).bytes();"
+            )
+            .unwrap();
         }
         writeln!(
             out_functions,
-            "        auto serializer_{name} = serde::BincodeSerializer();"
+            "        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();"
+        )
+        .unwrap();
+        writeln!(out_functions).unwrap();
+        write!(
+            out_functions,
+            "        size_t res_size = {prefix}_{stream_name}_into("
         )
         .unwrap();
+        for (arg_name, tpe) in inputs.iter() {
+            if *arg_name == "self" {
+                write!(out_functions, "this->inner, ").unwrap();
+            } else if !config.varint_encoding && scalar_encoded_size(tpe).is_some() {
+                write!(
+                    out_functions,
+                    "serializer_{arg_name}.data(), serializer_{arg_name}.size(), "
+                )
+                .unwrap();
+            } else {
+                write!(
+                    out_functions,
+                    "{arg_name}_serialized.data(), {arg_name}_serialized.size(), "
+                )
+                .unwrap();
+            }
+        }
         writeln!(
             out_functions,
-            "        serde::Serializable<{tpe}>::serialize({name}, serializer_{name});"
+            "&result_buffer, [](void* ctx, size_t len) -> uint8_t* {{ try {{ auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); }} catch (...) {{ return nullptr; }} }});"
         )
         .unwrap();
+        for (arg_name, tpe) in inputs.iter() {
+            if *arg_name == "self"
+                || (!config.varint_encoding && scalar_encoded_size(tpe).is_some())
+            {
+                continue;
+            }
+            writeln!(
+                out_functions,
+                "        serde::BufferPool::release(std::move({arg_name}_serialized));"
+            )
+            .unwrap();
+        }
+        writeln!(out_functions).unwrap();
+        if config.compressed_payloads {
+            writeln!(out_functions, "        auto payload = serde::decode_compressed_payload(std::move(result_buffer), res_size);").unwrap();
+        }
         writeln!(
             out_functions,
-            "        std::vector<uint8_t> {name}_serialized = std::move(serializer_{name}).bytes();"
+            "        auto deserializer = {deserializer_type}({payload_data}, {payload_len});"
         )
         .unwrap();
-    }
-    writeln!(out_functions, "        uint8_t* out_ptr = nullptr;").unwrap();
-    writeln!(out_functions).unwrap();
-    write!(
-        out_functions,
-        "        size_t res_size = {}_{}(",
-        prefix,
-        item.name.as_deref().unwrap(),
-    )
-    .unwrap();
-    for (name, _) in inputs.iter() {
-        if *name == "self" {
-            write!(out_functions, "this->inner, ").unwrap();
+        if unwraps_result {
+            writeln!(
+                out_functions,
+                "        if (deserializer.deserialize_variant_index() != 0) {{ // Err"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "            auto error = serde::Deserializable<SerializableError>::deserialize(deserializer);"
+            )
+            .unwrap();
+            writeln!(
+                out_functions,
+                "            serde::BufferPool::release(std::move({payload_buffer}));"
+            )
+            .unwrap();
+            writeln!(out_functions, "            throw error;").unwrap();
+            writeln!(out_functions, "        }}").unwrap();
+        }
+        if config.compressed_payloads {
+            writeln!(out_functions, "        return {stream_type}(std::move(payload.buffer), payload.offset + deserializer.get_buffer_offset(), payload.offset + payload.size);").unwrap();
         } else {
-            write!(
+            writeln!(
                 out_functions,
-                "{name}_serialized.data(), {name}_serialized.size(), "
+                "        return {stream_type}(std::move(result_buffer), deserializer.get_buffer_offset(), res_size);"
             )
             .unwrap();
         }
+        writeln!(out_functions, "    }}\n").unwrap();
+    }
+
+    // Batched variant: serialize all inputs into one buffer, cross the FFI
+    // boundary once and deserialize all results together
+    let batch_inputs = inputs
+        .iter()
+        .filter(|(n, _)| *n != "self")
+        .collect::<Vec<_>>();
+    if !unwraps_result || batch_inputs.is_empty() {
+        return;
     }
-    writeln!(out_functions, "&out_ptr);").unwrap();
+    let batch_type = if batch_inputs.len() == 1 {
+        format!("std::vector<{}>", batch_inputs[0].1)
+    } else {
+        let element_types = batch_inputs
+            .iter()
+            .map(|(_, tpe)| tpe.as_str())
+            .collect::<Vec<_>>()
+            .join(", ");
+        format!("std::vector<std::tuple<{element_types}>>")
+    };
+    let batch_return_type = if return_output_type == "void" {
+        Cow::Borrowed("void")
+    } else {
+        Cow::Owned(format!("std::vector<{return_output_type}>"))
+    };
+    let name = item.name.as_deref().unwrap();
+    writeln!(
+        out_functions,
+        "    // Batched variant of `{name}` that crosses the FFI boundary only once"
+    )
+    .unwrap();
+    writeln!(
+        out_functions,
+        "    inline {batch_return_type} {name}_batch(const {batch_type}& batch) {{"
+    )
+    .unwrap();
+    writeln!(
+        out_functions,
+        "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);"
+    )
+    .unwrap();
+    writeln!(
+        out_functions,
+        "        auto serializer_batch = {serializer_type}(serde::BufferPool::acquire());"
+    )
+    .unwrap();
+    writeln!(
+        out_functions,
+        "        serializer_batch.reserve(serde::serialized_size(batch));"
+    )
+    .unwrap();
+    writeln!(
+        out_functions,
+        "        serde::Serializable<{batch_type}>::serialize(batch, serializer_batch);"
+    )
+    .unwrap();
+    writeln!(
+        out_functions,
+        "        std::vector<uint8_t> batch_serialized = std::move(serializer_batch).bytes();"
+    )
+    .unwrap();
+    writeln!(
+        out_functions,
+        "        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, batch_serialized.size());"
+    )
+    .unwrap();
+    writeln!(out_functions, "        uint8_t* out_ptr = nullptr;").unwrap();
     writeln!(out_functions).unwrap();
     writeln!(
         out_functions,
-        "        std::vector<uint8_t> serialized_result(out_ptr, out_ptr + res_size);"
+        "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);"
+    )
+    .unwrap();
+    if impl_type.is_some() {
+        writeln!(
+            out_functions,
+            "        size_t res_size = {prefix}_{name}_batch(this->inner, batch_serialized.data(), batch_serialized.size(), &out_ptr);"
+        )
+        .unwrap();
+    } else {
+        writeln!(
+            out_functions,
+            "        size_t res_size = {prefix}_{name}_batch(batch_serialized.data(), batch_serialized.size(), &out_ptr);"
+        )
+        .unwrap();
+    }
+    writeln!(
+        out_functions,
+        "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);"
     )
     .unwrap();
     writeln!(
         out_functions,
-        "        {output_type} out = {output_type}::bincodeDeserialize(serialized_result);"
+        "        serde::BufferPool::release(std::move(batch_serialized));"
     )
     .unwrap();
+    // the response buffer is owned by a guard so it is returned to Rust on
+    // every exit path, including exceptions thrown during deserialization
+    writeln!(out_functions, "        struct ResultBufferGuard {{").unwrap();
+    writeln!(out_functions, "            uint8_t* ptr;").unwrap();
+    writeln!(out_functions, "            size_t size;").unwrap();
     writeln!(
         out_functions,
-        "        {prefix}_free_byte_buffer(out_ptr, res_size);"
+        "            ~ResultBufferGuard() {{ {prefix}_free_byte_buffer(ptr, size); }}"
     )
     .unwrap();
+    writeln!(out_functions, "        }} out_guard{{out_ptr, res_size}};").unwrap();
     writeln!(out_functions).unwrap();
-    if matches!(m.sig.output, Some(rustdoc_types::Type::ResolvedPath(ref p)) if get_name_without_path(&p.path) == "Result")
-    {
+    if config.chunked_batch {
+        // chunk-indexed framing (see the `chunked_batch` feature of
+        // `buffi_macro`): a raw little-endian header plus an offset table,
+        // decoded concurrently by `serde::deserialize_chunked_sequence`
+        writeln!(out_functions, "        if (res_size < sizeof(uint32_t)) {{").unwrap();
         writeln!(
             out_functions,
-            "        if (out.value.index() == 0) {{ // Ok"
+            "            throw serde::deserialization_error(\"Chunked batch response is truncated\");"
+        )
+        .unwrap();
+        writeln!(out_functions, "        }}").unwrap();
+        writeln!(
+            out_functions,
+            "        if (serde::read_le_u32(out_ptr) != 0) {{ // Err"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "            auto deserializer = {deserializer_type}(out_ptr + sizeof(uint32_t), res_size - sizeof(uint32_t));"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "            auto error = serde::Deserializable<SerializableError>::deserialize(deserializer);"
+        )
+        .unwrap();
+        writeln!(out_functions, "            throw error;").unwrap();
+        writeln!(out_functions, "        }}").unwrap();
+        writeln!(
+            out_functions,
+            "        std::vector<{output_type}> results = serde::deserialize_chunked_sequence<{output_type}, {deserializer_type}>(out_ptr + sizeof(uint32_t), res_size - sizeof(uint32_t));"
+        )
+        .unwrap();
+        writeln!(out_functions).unwrap();
+    } else {
+        writeln!(
+            out_functions,
+            "        auto deserializer = {deserializer_type}(out_ptr, res_size);"
         )
         .unwrap();
-        if return_output_type == "void" {
-            writeln!(out_functions, "            return;").unwrap();
-        } else {
-            writeln!(
-                out_functions,
-                "            auto ok = std::get<0>(out.value);"
-            )
-            .unwrap();
-            writeln!(out_functions, "            return std::get<0>(ok.value);").unwrap();
-        }
-        writeln!(out_functions, "        }} else {{ // Err").unwrap();
         writeln!(
             out_functions,
-            "            auto err = std::get<1>(out.value);"
+            "        if (deserializer.deserialize_variant_index() != 0) {{ // Err"
         )
         .unwrap();
         writeln!(
             out_functions,
-            "            auto error = std::get<0>(err.value);"
+            "            auto error = serde::Deserializable<SerializableError>::deserialize(deserializer);"
         )
         .unwrap();
         writeln!(out_functions, "            throw error;").unwrap();
         writeln!(out_functions, "        }}").unwrap();
+        writeln!(
+            out_functions,
+            "        std::vector<{output_type}> results = serde::Deserializable<std::vector<{output_type}>>::deserialize(deserializer);"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "        if (deserializer.get_buffer_offset() < res_size) {{"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "            throw serde::deserialization_error(\"Some input bytes were not read\");"
+        )
+        .unwrap();
+        writeln!(out_functions, "        }}").unwrap();
+        writeln!(out_functions).unwrap();
+    }
+    writeln!(
+        out_functions,
+        "        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);"
+    )
+    .unwrap();
+    writeln!(out_functions, "        BUFFI_INSTRUMENT_CALL(\"{name}_batch\", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);").unwrap();
+    if return_output_type == "void" {
+        writeln!(out_functions, "        for (auto& res : results) {{").unwrap();
+        writeln!(
+            out_functions,
+            "            if (res.value.index() != 0) {{ // Err"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "                auto err = std::get<1>(std::move(res.value));"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "                auto error = std::get<0>(std::move(err.value));"
+        )
+        .unwrap();
+        writeln!(out_functions, "                throw error;").unwrap();
+        writeln!(out_functions, "            }}").unwrap();
+        writeln!(out_functions, "        }}").unwrap();
     } else {
+        writeln!(out_functions, "        {batch_return_type} out;").unwrap();
+        writeln!(out_functions, "        out.reserve(results.size());").unwrap();
+        writeln!(out_functions, "        for (auto& res : results) {{").unwrap();
+        writeln!(
+            out_functions,
+            "            if (res.value.index() == 0) {{ // Ok"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "                auto ok = std::get<0>(std::move(res.value));"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "                out.push_back(std::get<0>(std::move(ok.value)));"
+        )
+        .unwrap();
+        writeln!(out_functions, "            }} else {{ // Err").unwrap();
+        writeln!(
+            out_functions,
+            "                auto err = std::get<1>(std::move(res.value));"
+        )
+        .unwrap();
+        writeln!(
+            out_functions,
+            "                auto error = std::get<0>(std::move(err.value));"
+        )
+        .unwrap();
+        writeln!(out_functions, "                throw error;").unwrap();
+        writeln!(out_functions, "            }}").unwrap();
+        writeln!(out_functions, "        }}").unwrap();
         writeln!(out_functions, "        return out;").unwrap();
     }
     writeln!(out_functions, "    }}\n").unwrap();
@@ -890,13 +1949,313 @@ fn generate_type_definitions(
         })
         .collect::<serde_reflection::Registry>();
 
+    let types_header = PathBuf::from(out_types).join(format!("{}.hpp", config.namespace));
+    let flat_maps = config.flat_maps;
+    let cow_value_ptr = config.cow_value_ptr;
+    let extern_templates = config.extern_templates;
+    let (serializer_type, deserializer_type) = if config.varint_encoding {
+        (
+            "serde::BincodeCompactSerializer",
+            "serde::BincodeCompactDeserializer",
+        )
+    } else {
+        ("serde::BincodeSerializer", "serde::BincodeDeserializer")
+    };
+    let namespace = config.namespace.clone();
     let config = serde_generate::CodeGeneratorConfig::new(config.namespace.to_owned())
         .with_comments(comments.unwrap())
         .with_encodings([serde_generate::Encoding::Bincode]);
     let installer = serde_generate::cpp::Installer::new(PathBuf::from(out_types));
     installer.install_module(&config, &registry).unwrap();
-    installer.install_serde_runtime().unwrap();
-    installer.install_bincode_runtime().unwrap();
+    if flat_maps {
+        // serde-generate hardcodes `std::map` for map-typed fields; rewrite
+        // the installed types header so those fields use the sorted-vector
+        // `serde::flat_map` from the runtime instead. The generated
+        // member-wise serialization refers to fields via `decltype`, so it
+        // picks up the replacement automatically.
+        let content = fs::read_to_string(&types_header).unwrap();
+        fs::write(
+            &types_header,
+            content.replace("std::map<", "serde::flat_map<"),
+        )
+        .unwrap();
+    }
+    if cow_value_ptr {
+        // same post-processing approach for recursive fields: serde-generate
+        // hardcodes `serde::value_ptr`, and `serde::cow_ptr` shares its wire
+        // format and interface, so a textual swap is sufficient
+        let content = fs::read_to_string(&types_header).unwrap();
+        fs::write(
+            &types_header,
+            content.replace("serde::value_ptr<", "serde::cow_ptr<"),
+        )
+        .unwrap();
+    }
+    // storage-reusing deserialization companions: a `bincodeDeserializeInto`
+    // method next to each top-level `bincodeDeserialize`, plus
+    // `Deserializable<T>::deserialize_into` member specializations that
+    // assign into existing fields via `serde::deserialize_into`, so polling
+    // loops receiving structurally identical values reuse string/vector
+    // capacity instead of reallocating on every call
+    {
+        let content = fs::read_to_string(&types_header).unwrap();
+        let mut rewritten = String::with_capacity(content.len() + 4096);
+        let mut lines = content.lines();
+        while let Some(line) = lines.next() {
+            rewritten.push_str(line);
+            rewritten.push('\n');
+            let trimmed = line.trim_start();
+            let indent = line.len() - trimmed.len();
+            // method declaration inside a top-level struct definition
+            if indent == 8
+                && trimmed.starts_with("static ")
+                && trimmed.ends_with(" bincodeDeserialize(std::vector<uint8_t>);")
+            {
+                let tpe = &trimmed["static ".len()
+                    ..trimmed.len() - " bincodeDeserialize(std::vector<uint8_t>);".len()];
+                rewritten.push_str(&format!(
+                    "        static void bincodeDeserializeInto({tpe} &, const std::vector<uint8_t> &);\n"
+                ));
+            }
+            // method definition below the struct; the counterpart is emitted
+            // right after the copied block
+            if indent == 4
+                && trimmed.starts_with("inline ")
+                && trimmed.contains("::bincodeDeserialize(std::vector<uint8_t> input) {")
+            {
+                let tpe = trimmed["inline ".len()..].split(' ').next().unwrap();
+                if !tpe.contains("::") {
+                    for body_line in lines.by_ref() {
+                        rewritten.push_str(body_line);
+                        rewritten.push('\n');
+                        if body_line == "    }" {
+                            break;
+                        }
+                    }
+                    rewritten.push_str(&format!(
+                        "\n    inline void {tpe}::bincodeDeserializeInto({tpe} &out, const std::vector<uint8_t> &input) {{\n        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());\n        serde::deserialize_into(out, deserializer);\n        if (deserializer.get_buffer_offset() < input.size()) {{\n            throw serde::deserialization_error(\"Some input bytes were not read\");\n        }}\n    }}\n"
+                    ));
+                }
+            }
+        }
+        for (name, format) in &registry {
+            let qualified = format!("{namespace}::{name}");
+            rewritten.push_str("\ntemplate <>\ntemplate <typename Deserializer>\n");
+            rewritten.push_str(&format!(
+                "void serde::Deserializable<{qualified}>::deserialize_into({qualified} &obj, Deserializer &deserializer) {{\n"
+            ));
+            if let serde_reflection::ContainerFormat::Struct(fields) = format {
+                rewritten.push_str("    deserializer.increase_container_depth();\n");
+                for field in fields {
+                    rewritten.push_str(&format!(
+                        "    serde::deserialize_into(obj.{}, deserializer);\n",
+                        field.name
+                    ));
+                }
+                rewritten.push_str("    deserializer.decrease_container_depth();\n");
+            } else {
+                // enums and tuple-like containers hold their payload in a
+                // variant or tuple, where assignment cannot reuse the
+                // previous storage anyway
+                rewritten.push_str(&format!(
+                    "    obj = serde::Deserializable<{qualified}>::deserialize(deserializer);\n"
+                ));
+            }
+            rewritten.push_str("}\n");
+        }
+        fs::write(&types_header, rewritten).unwrap();
+    }
+    if extern_templates {
+        // serde-generate only supports a single types header, so the
+        // per-type split happens at the instantiation level instead: a
+        // companion header declares every serialization instantiation as
+        // `extern template`, and a companion .cpp (compiled once into the
+        // client) provides them, so including TUs stop re-instantiating
+        // the machinery for every type
+        let mut declarations = String::new();
+        let mut definitions = String::new();
+        for name in registry.keys() {
+            let qualified = format!("{namespace}::{name}");
+            declarations.push_str(&format!(
+                "extern template void serde::Serializable<{qualified}>::serialize<{serializer_type}>(const {qualified} &, {serializer_type} &);\n"
+            ));
+            declarations.push_str(&format!(
+                "extern template {qualified} serde::Deserializable<{qualified}>::deserialize<{deserializer_type}>({deserializer_type} &);\n"
+            ));
+            definitions.push_str(&format!(
+                "template void serde::Serializable<{qualified}>::serialize<{serializer_type}>(const {qualified} &, {serializer_type} &);\n"
+            ));
+            definitions.push_str(&format!(
+                "template {qualified} serde::Deserializable<{qualified}>::deserialize<{deserializer_type}>({deserializer_type} &);\n"
+            ));
+        }
+        fs::write(
+            PathBuf::from(out_types).join(format!("{namespace}_extern_templates.hpp")),
+            format!(
+                "#pragma once\n\n#include \"bincode.hpp\"\n#include \"{namespace}.hpp\"\n\n// Explicit instantiation declarations for the serialization machinery of\n// every generated type. Include this header next to `{namespace}.hpp` so\n// translation units stop instantiating the templates themselves; the\n// definitions live in `{namespace}_extern_templates.cpp`, which must be\n// compiled into the client exactly once.\n\n{declarations}"
+            ),
+        )
+        .unwrap();
+        fs::write(
+            PathBuf::from(out_types).join(format!("{namespace}_extern_templates.cpp")),
+            format!("#include \"{namespace}_extern_templates.hpp\"\n\n{definitions}"),
+        )
+        .unwrap();
+    }
+    install_runtime(out_types);
+}
+
+/// Write BuFFI's copy of the C++ serde/bincode runtime to the output directory
+fn install_runtime(out_dir: &str) {
+    let out_dir = PathBuf::from(out_dir);
+    for (file_name, content) in [
+        ("serde.hpp", SERDE_RUNTIME),
+        ("binary.hpp", BINARY_RUNTIME),
+        ("bincode.hpp", BINCODE_RUNTIME),
+    ] {
+        fs::write(out_dir.join(file_name), content).unwrap();
+    }
+}
+
+/// Emit a thread-safe pool of `{name}*` handles next to the holder class,
+/// so concurrent callers check out their own handle instead of serializing
+/// on a single shared one
+fn write_holder_pool<W: std::io::Write>(writer: &mut W, name: &str) {
+    let pool = format!(
+        r#"// A thread-safe pool of {name}* handles for concurrent callers. Each
+// thread keeps affinity with the handle it released last (checked without
+// locking), then falls back to the mutex-guarded shared free list, and
+// finally to the user-supplied factory when the pool runs dry. Handles are
+// checked out RAII-style; every handle created through the pool is
+// destroyed with it, so the pool must outlive all checkouts and should
+// normally live for the whole program.
+class {name}HolderPool {{
+public:
+    {name}HolderPool(std::function<{name}*()> factory, std::function<void({name}*)> destroy = {{}})
+        : factory_(std::move(factory)), destroy_(std::move(destroy)) {{
+    }}
+
+    {name}HolderPool(const {name}HolderPool&) = delete;
+    {name}HolderPool& operator=(const {name}HolderPool&) = delete;
+
+    ~{name}HolderPool() {{
+        if (!destroy_) {{
+            return;
+        }}
+        std::lock_guard<std::mutex> guard(mutex_);
+        for ({name}* handle : owned_) {{
+            destroy_(handle);
+        }}
+    }}
+
+    // RAII checkout: behaves like a {name}Holder and returns the handle to
+    // the pool when it goes out of scope.
+    class Checkout {{
+    public:
+        Checkout({name}HolderPool* pool, {name}* handle) : pool_(pool), holder_(handle), handle_(handle) {{
+        }}
+        Checkout(Checkout&& other) : pool_(other.pool_), holder_(other.handle_), handle_(other.handle_) {{
+            other.pool_ = nullptr;
+        }}
+        Checkout(const Checkout&) = delete;
+        Checkout& operator=(const Checkout&) = delete;
+        Checkout& operator=(Checkout&&) = delete;
+        ~Checkout() {{
+            if (pool_ != nullptr) {{
+                pool_->put_back(handle_);
+            }}
+        }}
+
+        {name}Holder* operator->() {{ return &holder_; }}
+        {name}Holder& operator*() {{ return holder_; }}
+
+    private:
+        {name}HolderPool* pool_;
+        {name}Holder holder_;
+        {name}* handle_;
+    }};
+
+    Checkout acquire() {{
+        {name}** slot = affinity_slot();
+        if (*slot != nullptr) {{
+            {name}* handle = *slot;
+            *slot = nullptr;
+            return Checkout(this, handle);
+        }}
+        {{
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (!free_.empty()) {{
+                {name}* handle = free_.back();
+                free_.pop_back();
+                return Checkout(this, handle);
+            }}
+        }}
+        {name}* handle = factory_();
+        std::lock_guard<std::mutex> guard(mutex_);
+        owned_.push_back(handle);
+        return Checkout(this, handle);
+    }}
+
+private:
+    void put_back({name}* handle) {{
+        {name}** slot = affinity_slot();
+        if (*slot == nullptr) {{
+            *slot = handle;
+            return;
+        }}
+        std::lock_guard<std::mutex> guard(mutex_);
+        free_.push_back(handle);
+    }}
+
+    // One cached handle per thread and pool: the common acquire/release
+    // cycle on a steady thread never touches the shared lock. Slots are
+    // keyed by a unique pool id rather than only the pool address, so
+    // entries left behind by a destroyed pool are never handed out again
+    // by a later pool allocated at the same address.
+    struct AffinitySlot {{
+        uint64_t pool_id;
+        {name}* handle;
+    }};
+
+    {name}** affinity_slot() {{
+        thread_local std::map<const {name}HolderPool*, AffinitySlot> slots;
+        AffinitySlot& slot = slots[this];
+        if (slot.pool_id != id_) {{
+            slot.pool_id = id_;
+            slot.handle = nullptr;
+        }}
+        return &slot.handle;
+    }}
+
+    static uint64_t next_pool_id() {{
+        static std::atomic<uint64_t> counter{{0}};
+        return counter.fetch_add(1) + 1;
+    }}
+
+    std::function<{name}*()> factory_;
+    std::function<void({name}*)> destroy_;
+    const uint64_t id_ = next_pool_id();
+    std::mutex mutex_;
+    std::vector<{name}*> free_;
+    std::vector<{name}*> owned_;
+}};
+
+"#
+    );
+    writer.write_all(pool.as_bytes()).unwrap();
+}
+
+/// Static bound for the bincode-encoded size of fixed-width scalar C++
+/// types under the legacy (fixed integer) encoding; `None` for types whose
+/// encoded size depends on the value
+fn scalar_encoded_size(tpe: &str) -> Option<usize> {
+    match tpe {
+        "bool" | "int8_t" | "uint8_t" => Some(1),
+        "int16_t" | "uint16_t" => Some(2),
+        "int32_t" | "uint32_t" | "float" => Some(4),
+        "int64_t" | "uint64_t" | "double" => Some(8),
+        _ => None,
+    }
 }
 
 fn to_cpp_type_name(f: &serde_reflection::Format) -> String {
@@ -1962,6 +3321,8 @@ fn to_c_type(tpe: &rustdoc_types::Type) -> String {
             let mut ret = get_name_without_path(&p.path).trim().to_string();
             if ret == "c_char" {
                 String::from("char")
+            } else if ret == "c_void" {
+                String::from("void")
             } else {
                 if let Some(rustdoc_types::GenericArgs::AngleBracketed { args, .. }) =
                     p.args.as_deref()
@@ -2020,6 +3381,23 @@ fn generate_extern_c_function_def(name: &str, func: &rustdoc_types::Function) ->
         .inputs
         .iter()
         .map(|(name, tpe)| {
+            if let rustdoc_types::Type::FunctionPointer(f) = tpe {
+                // a parameter of function type adjusts to pointer-to-function
+                let ret = f
+                    .sig
+                    .output
+                    .as_ref()
+                    .map(to_c_type)
+                    .unwrap_or_else(|| "void".into());
+                let params = f
+                    .sig
+                    .inputs
+                    .iter()
+                    .map(|(_, t)| to_c_type(t))
+                    .collect::<Vec<_>>()
+                    .join(", ");
+                return format!("{ret} {name}({params})");
+            }
             let mut out = to_c_type(tpe);
             write!(out, " {name}").unwrap();
             out
@@ -114,8 +114,19 @@ fn generate_exported_function<'a>(
     }
 
     let is_free_standing = arg_list.is_empty();
+    // both sides must agree on the integer encoding; the C++ side selects
+    // the matching (de)serializer via `Config::varint_encoding`
+    let bincode_config = if cfg!(feature = "varint_encoding") {
+        quote::quote!(buffi::bincode::config::standard())
+    } else {
+        quote::quote!(buffi::bincode::config::legacy())
+    };
+    let mut batch_arg_list = arg_list.clone();
     let name = &sig.ident;
     let fn_name = syn::Ident::new(&format!("{}_{}", prefix, sig.ident), sig.ident.span());
+    let fn_name_batch =
+        syn::Ident::new(&format!("{}_{}_batch", prefix, sig.ident), sig.ident.span());
+    let fn_name_into = syn::Ident::new(&format!("{}_{}_into", prefix, sig.ident), sig.ident.span());
     for arg in &sig.inputs {
         if let syn::FnArg::Typed(t) = arg {
             let n = if let syn::Pat::Ident(ref i) = *t.pat {
@@ -128,7 +139,12 @@ fn generate_exported_function<'a>(
             arg_list.push(quote::quote!(#n_size: usize));
         }
     }
+    let mut into_arg_list = arg_list.clone();
     arg_list.push(quote::quote!(out_ptr: *mut *mut u8));
+    into_arg_list.push(quote::quote!(out: *mut core::ffi::c_void));
+    into_arg_list.push(quote::quote!(
+        provide: unsafe extern "C" fn(*mut core::ffi::c_void, usize) -> *mut u8
+    ));
     let deserialized_args = sig.inputs.iter().filter_map(|arg| {
         let span = arg.span();
         if let syn::FnArg::Typed(t) = arg {
@@ -146,24 +162,29 @@ fn generate_exported_function<'a>(
                         std::slice::from_raw_parts(#n, #n_size)
                     }
                 };
-                let #n = buffi::bincode::serde::decode_from_slice(slice, buffi::bincode::config::legacy())?.0;
+                let #n = buffi::bincode::serde::decode_from_slice(slice, #bincode_config)?.0;
             })
         } else {
             None
         }
     });
-    let args = sig.inputs.iter().filter_map(|arg| {
-        if let syn::FnArg::Typed(t) = arg {
-            let n = if let syn::Pat::Ident(ref i) = *t.pat {
-                i.ident.clone()
+    let deserialized_args = deserialized_args.collect::<Vec<_>>();
+    let args = sig
+        .inputs
+        .iter()
+        .filter_map(|arg| {
+            if let syn::FnArg::Typed(t) = arg {
+                let n = if let syn::Pat::Ident(ref i) = *t.pat {
+                    i.ident.clone()
+                } else {
+                    panic!("unknown")
+                };
+                Some(n)
             } else {
-                panic!("unknown")
-            };
-            Some(n)
-        } else {
-            None
-        }
-    });
+                None
+            }
+        })
+        .collect::<Vec<_>>();
     let mut_this = sig.inputs.first().and_then(|s| {
         if let syn::FnArg::Receiver(r) = s {
             r.mutability.map(|_| quote::quote!(mut))
@@ -233,20 +254,30 @@ fn generate_exported_function<'a>(
             return Err(crate::errors::SerializableError::from("Out pointer is null".to_string()));
         }
     };
+    let this_ptr_batch = this_ptr.clone();
+    let this_ptr_into = this_ptr.clone();
+    let out_ptr_batch = out_ptr.clone();
+    let deserialized_args_into = deserialized_args.clone();
     let deserialize = quote::quote! {
         #this_ptr
         #out_ptr
         #(#deserialized_args)*
     };
+    let deserialize_into = quote::quote! {
+        #this_ptr_into
+        #(#deserialized_args_into)*
+    };
+    let call_args = args.clone();
     let inner_block = if is_free_standing {
         quote::quote! {
-            #name(#(#args,)*)#await_call #map_err_call
+            #name(#(#call_args,)*)#await_call #map_err_call
         }
     } else {
         quote::quote_spanned! {item_span=>
-            this.#name(#(#args,)*)#await_call #map_err_call
+            this.#name(#(#call_args,)*)#await_call #map_err_call
         }
     };
+    let call_block_into = inner_block.clone();
     let inner_block = if sig.asyncness.is_some() {
         quote::quote! {
             #deserialize
@@ -262,6 +293,228 @@ fn generate_exported_function<'a>(
             #inner_block
         }
     };
+    let inner_block_into = if sig.asyncness.is_some() {
+        quote::quote! {
+            #deserialize_into
+            let runtime = std::sync::Arc::clone(&this.runtime);
+            let fut = async move {
+                #call_block_into
+            };
+            runtime.block_on(fut)
+        }
+    } else {
+        quote::quote! {
+            #deserialize_into
+            #call_block_into
+        }
+    };
+    let tracing_serializable_w_into = tracing_serializable_w.clone();
+    let tracing_serializable_e_into = tracing_serializable_e.clone();
+    let tracing_serializable_w_chunked = tracing_serializable_w.clone();
+    let tracing_serializable_e_chunked = tracing_serializable_e.clone();
+    // serialize `res` and hand the resulting byte buffer over to the caller,
+    // shared between the plain and the batched export
+    let encode_result = quote::quote! {
+        let bytes = match buffi::bincode::serde::encode_to_vec(&res, #bincode_config) {
+            Ok(bytes) => {
+                bytes
+            }
+            Err(e) => {
+                #tracing_serializable_w
+                res = Err(e.into());
+                match buffi::bincode::serde::encode_to_vec(&res, #bincode_config) {
+                    Ok(bytes) => {
+                        bytes
+                    }
+                    Err(_e) => {
+                        #tracing_serializable_e
+                        Vec::new()
+                    }
+                }
+            }
+        };
+
+        let bytes = bytes.into_boxed_slice();
+        let len = bytes.len();
+        let out: &mut *mut u8 = unsafe { &mut *out_ptr };
+        *out = Box::into_raw(bytes) as *mut u8;
+        len
+    };
+    // With the `chunked_batch` feature the batched export frames its result
+    // as [variant: u32 le][count: u64 le][offsets: u64 le * count]
+    // [elements...]: the offset table records every element's byte position
+    // so the C++ side can deserialize chunks concurrently. The raw
+    // little-endian header reads the same under both integer encodings;
+    // only the elements (and the error payload) use the bincode config.
+    let encode_result_batch = if cfg!(feature = "chunked_batch") {
+        quote::quote! {
+            let mut encoded: Option<Vec<u8>> = None;
+            if let Ok(results) = &res {
+                let mut bytes: Vec<u8> = Vec::new();
+                bytes.extend_from_slice(&0u32.to_le_bytes());
+                bytes.extend_from_slice(&(results.len() as u64).to_le_bytes());
+                let table_start = bytes.len();
+                bytes.resize(table_start + results.len() * 8, 0);
+                let elements_start = bytes.len();
+                let mut failed = None;
+                for (i, element) in results.iter().enumerate() {
+                    let offset = (bytes.len() - elements_start) as u64;
+                    bytes[table_start + i * 8..table_start + (i + 1) * 8]
+                        .copy_from_slice(&offset.to_le_bytes());
+                    match buffi::bincode::serde::encode_to_vec(element, #bincode_config) {
+                        Ok(element_bytes) => bytes.extend_from_slice(&element_bytes),
+                        Err(e) => {
+                            failed = Some(e);
+                            break;
+                        }
+                    }
+                }
+                match failed {
+                    None => encoded = Some(bytes),
+                    Some(e) => {
+                        #tracing_serializable_w_chunked
+                        res = Err(e.into());
+                    }
+                }
+            }
+            let bytes = match encoded {
+                Some(bytes) => bytes,
+                None => {
+                    let mut bytes = 1u32.to_le_bytes().to_vec();
+                    if let Err(error) = &res {
+                        match buffi::bincode::serde::encode_to_vec(error, #bincode_config) {
+                            Ok(error_bytes) => bytes.extend_from_slice(&error_bytes),
+                            Err(_e) => {
+                                #tracing_serializable_e_chunked
+                                bytes.clear();
+                            }
+                        }
+                    }
+                    bytes
+                }
+            };
+
+            let bytes = bytes.into_boxed_slice();
+            let len = bytes.len();
+            let out: &mut *mut u8 = unsafe { &mut *out_ptr };
+            *out = Box::into_raw(bytes) as *mut u8;
+            len
+        }
+    } else {
+        encode_result.clone()
+    };
+    // serialize `res` directly into memory the caller owns: the encoder
+    // streams into the region returned by `provide`, which is re-invoked
+    // with a growing length as needed, so large results never pass through
+    // an intermediate Rust-allocated buffer.
+    //
+    // With the `compressed_payloads` feature the response is instead framed
+    // with a leading tag byte: 0 for a raw bincode payload, 1 for
+    // [raw_len: u64 le][lz4 block]. Responses below the size threshold (or
+    // that would not shrink) stay raw, so small low-latency calls only pay
+    // for the tag byte and a branch on the C++ side.
+    let encode_result_into = if cfg!(feature = "compressed_payloads") {
+        quote::quote! {
+            const COMPRESSION_THRESHOLD: usize = 512;
+            let bytes = match buffi::bincode::serde::encode_to_vec(&res, #bincode_config) {
+                Ok(bytes) => bytes,
+                Err(e) => {
+                    #tracing_serializable_w_into
+                    res = Err(e.into());
+                    match buffi::bincode::serde::encode_to_vec(&res, #bincode_config) {
+                        Ok(bytes) => bytes,
+                        Err(_e) => {
+                            #tracing_serializable_e_into
+                            Vec::new()
+                        }
+                    }
+                }
+            };
+            let mut framed = Vec::with_capacity(bytes.len() + 1);
+            if bytes.len() >= COMPRESSION_THRESHOLD {
+                let compressed = buffi::lz4_flex::block::compress(&bytes);
+                if compressed.len() + 1 + core::mem::size_of::<u64>() < bytes.len() + 1 {
+                    framed.push(1u8);
+                    framed.extend_from_slice(&(bytes.len() as u64).to_le_bytes());
+                    framed.extend_from_slice(&compressed);
+                }
+            }
+            if framed.is_empty() {
+                framed.push(0u8);
+                framed.extend_from_slice(&bytes);
+            }
+            let dst = unsafe { provide(out, framed.len()) };
+            if dst.is_null() {
+                0
+            } else {
+                unsafe {
+                    std::ptr::copy_nonoverlapping(framed.as_ptr(), dst, framed.len());
+                }
+                framed.len()
+            }
+        }
+    } else {
+        quote::quote! {
+            struct ProvideWriter {
+                out: *mut core::ffi::c_void,
+                provide: unsafe extern "C" fn(*mut core::ffi::c_void, usize) -> *mut u8,
+                written: usize,
+            }
+
+            impl buffi::bincode::enc::write::Writer for &mut ProvideWriter {
+                fn write(
+                    &mut self,
+                    bytes: &[u8],
+                ) -> Result<(), buffi::bincode::error::EncodeError> {
+                    let new_len = self.written + bytes.len();
+                    let dst = unsafe { (self.provide)(self.out, new_len) };
+                    if dst.is_null() {
+                        return Err(buffi::bincode::error::EncodeError::Other(
+                            "buffer provider returned a null pointer",
+                        ));
+                    }
+                    unsafe {
+                        std::ptr::copy_nonoverlapping(
+                            bytes.as_ptr(),
+                            dst.add(self.written),
+                            bytes.len(),
+                        );
+                    }
+                    self.written = new_len;
+                    Ok(())
+                }
+            }
+
+            let mut writer = ProvideWriter { out, provide, written: 0 };
+            match buffi::bincode::serde::encode_into_writer(&res, &mut writer, #bincode_config) {
+                Ok(()) => {}
+                Err(e) => {
+                    #tracing_serializable_w_into
+                    res = Err(e.into());
+                    // restart at the beginning of the same region, overwriting
+                    // whatever the failed attempt already streamed out
+                    writer.written = 0;
+                    match buffi::bincode::serde::encode_into_writer(&res, &mut writer, #bincode_config) {
+                        Ok(()) => {}
+                        Err(_e) => {
+                            #tracing_serializable_e_into
+                            writer.written = 0;
+                        }
+                    }
+                }
+            }
+            writer.written
+        }
+    };
+    let tracing_error_batch = tracing_error.clone();
+    let tracing_error_into = tracing_error.clone();
+    let tracing_skip_batch = tracing_skip.clone();
+    let tracing_skip_into = tracing_skip.clone();
+    let allow_unwrap_default_batch = allow_unwrap_default.clone();
+    let allow_unwrap_default_into = allow_unwrap_default.clone();
+    let docs = docs.collect::<Vec<_>>();
+    let docs_batch = docs.clone();
+    let docs_into = docs.clone();
     exports.push(quote::quote_spanned! {item_span=>
         #(#docs)*
         ///
@@ -286,30 +539,142 @@ fn generate_exported_function<'a>(
                     Err(crate::errors::SerializableError::from(e))
                 }
             };
-            let bytes = match buffi::bincode::serde::encode_to_vec(&res, buffi::bincode::config::legacy()) {
-                Ok(bytes) => {
-                    bytes
-                }
+            #encode_result
+        }
+    });
+
+    // caller-supplied buffer export: instead of handing out a Rust-allocated
+    // buffer that has to be freed in a second FFI crossing, the result is
+    // copied into memory the C++ side owns
+    exports.push(quote::quote_spanned! {item_span=>
+        #(#docs_into)*
+        ///
+        /// Variant that serializes the result into caller-provided memory:
+        /// the encoding is streamed into the region returned by `provide`,
+        /// which may be invoked several times with a growing length and must
+        /// return a writable buffer of at least that size whose first bytes
+        /// keep their previous content (a resized `std::vector` does).
+        /// Returns the encoded length.
+        ///
+        /// # Safety
+        /// Unsafe code is used to dereference pointers to byte buffers.
+        /// We check every pointer before accessing it to make this process safe.
+        #[cfg(not(generated_extern_function_marker))]
+        #tracing_skip_into
+        #allow_unwrap_default_into
+        #[unsafe(no_mangle)]
+        pub unsafe extern "C" fn #fn_name_into(#(#into_arg_list,)*) -> usize {
+            let r = std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| {
+                #inner_block_into
+            }));
+
+            let mut res = match r {
+                Ok(o) => {
+                    o
+                },
                 Err(e) => {
-                    #tracing_serializable_w
-                    res = Err(e.into());
-                    match buffi::bincode::serde::encode_to_vec(&res, buffi::bincode::config::legacy()) {
-                        Ok(bytes) => {
-                            bytes
-                        }
-                        Err(_e) => {
-                            #tracing_serializable_e
-                            Vec::new()
-                        }
-                    }
+                    #tracing_error_into
+                    Err(crate::errors::SerializableError::from(e))
                 }
             };
+            #encode_result_into
+        }
+    });
 
-            let bytes = bytes.into_boxed_slice();
-            let len = bytes.len();
-            let out: &mut *mut u8 = unsafe { &mut *out_ptr };
-            *out = Box::into_raw(bytes) as *mut u8;
-            len
+    // batched export: deserializes a `Vec` of argument tuples, performs all
+    // calls behind a single FFI crossing and returns a `Vec` of results
+    if args.is_empty() {
+        return Ok(());
+    }
+    batch_arg_list.push(quote::quote!(batch: *const u8));
+    batch_arg_list.push(quote::quote!(batch_size: usize));
+    batch_arg_list.push(quote::quote!(out_ptr: *mut *mut u8));
+    // the tuple pattern in the call loop cannot pin the container type on
+    // its own, so the decoded batch is annotated explicitly
+    let batch_types = sig
+        .inputs
+        .iter()
+        .filter_map(|arg| {
+            if let syn::FnArg::Typed(t) = arg {
+                Some(&*t.ty)
+            } else {
+                None
+            }
+        })
+        .collect::<Vec<_>>();
+    let deserialize_batch = quote::quote! {
+        #this_ptr_batch
+        #out_ptr_batch
+        let slice = if batch.is_null() {
+            &[]
+        } else {
+            unsafe {
+                std::slice::from_raw_parts(batch, batch_size)
+            }
+        };
+        let batch: Vec<(#(#batch_types,)*)> =
+            buffi::bincode::serde::decode_from_slice(slice, #bincode_config)?.0;
+    };
+    let pattern_args = args.clone();
+    let batch_call = if is_free_standing {
+        quote::quote! {
+            #name(#(#args,)*)#await_call #map_err_call
+        }
+    } else {
+        quote::quote_spanned! {item_span=>
+            this.#name(#(#args,)*)#await_call #map_err_call
+        }
+    };
+    let batch_loop = quote::quote! {
+        let mut results = Vec::with_capacity(batch.len());
+        for (#(#pattern_args,)*) in batch {
+            results.push(#batch_call);
+        }
+        Ok::<_, crate::errors::SerializableError>(results)
+    };
+    let batch_inner_block = if sig.asyncness.is_some() {
+        quote::quote! {
+            #deserialize_batch
+            let runtime = std::sync::Arc::clone(&this.runtime);
+            let fut = async move {
+                #batch_loop
+            };
+            runtime.block_on(fut)
+        }
+    } else {
+        quote::quote! {
+            #deserialize_batch
+            #batch_loop
+        }
+    };
+    exports.push(quote::quote_spanned! {item_span=>
+        #(#docs_batch)*
+        ///
+        /// Batched variant: processes a whole `Vec` of argument tuples in a
+        /// single call to amortize the per-call FFI overhead.
+        ///
+        /// # Safety
+        /// Unsafe code is used to dereference pointers to byte buffers.
+        /// We check every pointer before accessing it to make this process safe.
+        #[cfg(not(generated_extern_function_marker))]
+        #tracing_skip_batch
+        #allow_unwrap_default_batch
+        #[unsafe(no_mangle)]
+        pub unsafe extern "C" fn #fn_name_batch(#(#batch_arg_list,)*) -> usize {
+            let r = std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| {
+                #batch_inner_block
+            }));
+
+            let mut res = match r {
+                Ok(o) => {
+                    o
+                },
+                Err(e) => {
+                    #tracing_error_batch
+                    Err(crate::errors::SerializableError::from(e))
+                }
+            };
+            #encode_result_batch
         }
     });
 
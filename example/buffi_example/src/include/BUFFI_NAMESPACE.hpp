@@ -12,6 +12,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const DateTimeHelper&, const DateTimeHelper&);
         std::vector<uint8_t> bincodeSerialize() const;
         static DateTimeHelper bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(DateTimeHelper &, const std::vector<uint8_t> &);
     };
 
     struct RandomEnum {
@@ -37,6 +38,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const RandomEnum&, const RandomEnum&);
         std::vector<uint8_t> bincodeSerialize() const;
         static RandomEnum bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(RandomEnum &, const std::vector<uint8_t> &);
     };
 
     struct CustomType;
@@ -62,6 +64,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const CustomType&, const CustomType&);
         std::vector<uint8_t> bincodeSerialize() const;
         static CustomType bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(CustomType &, const std::vector<uint8_t> &);
     };
 
     struct SerializableError {
@@ -70,6 +73,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const SerializableError&, const SerializableError&);
         std::vector<uint8_t> bincodeSerialize() const;
         static SerializableError bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(SerializableError &, const std::vector<uint8_t> &);
     };
 
     struct Result_CustomType_SerializableError {
@@ -95,6 +99,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const Result_CustomType_SerializableError&, const Result_CustomType_SerializableError&);
         std::vector<uint8_t> bincodeSerialize() const;
         static Result_CustomType_SerializableError bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(Result_CustomType_SerializableError &, const std::vector<uint8_t> &);
     };
 
     struct Result_String_SerializableError {
@@ -120,6 +125,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const Result_String_SerializableError&, const Result_String_SerializableError&);
         std::vector<uint8_t> bincodeSerialize() const;
         static Result_String_SerializableError bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(Result_String_SerializableError &, const std::vector<uint8_t> &);
     };
 
     struct Result_i64_SerializableError {
@@ -145,6 +151,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const Result_i64_SerializableError&, const Result_i64_SerializableError&);
         std::vector<uint8_t> bincodeSerialize() const;
         static Result_i64_SerializableError bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(Result_i64_SerializableError &, const std::vector<uint8_t> &);
     };
 
     struct Result_void_SerializableError {
@@ -170,6 +177,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const Result_void_SerializableError&, const Result_void_SerializableError&);
         std::vector<uint8_t> bincodeSerialize() const;
         static Result_void_SerializableError bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(Result_void_SerializableError &, const std::vector<uint8_t> &);
     };
 
     struct Point1_f64 {
@@ -178,6 +186,7 @@ namespace BUFFI_NAMESPACE {
         friend bool operator==(const Point1_f64&, const Point1_f64&);
         std::vector<uint8_t> bincodeSerialize() const;
         static Point1_f64 bincodeDeserialize(std::vector<uint8_t>);
+        static void bincodeDeserializeInto(Point1_f64 &, const std::vector<uint8_t> &);
     };
 
 } // end of namespace BUFFI_NAMESPACE
@@ -211,6 +220,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void CustomType::bincodeDeserializeInto(CustomType &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -265,6 +282,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void DateTimeHelper::bincodeDeserializeInto(DateTimeHelper &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -307,6 +332,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void Point1_f64::bincodeDeserializeInto(Point1_f64 &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -349,6 +382,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void RandomEnum::bincodeDeserializeInto(RandomEnum &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -464,6 +505,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void Result_CustomType_SerializableError::bincodeDeserializeInto(Result_CustomType_SerializableError &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -582,6 +631,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void Result_String_SerializableError::bincodeDeserializeInto(Result_String_SerializableError &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -700,6 +757,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void Result_i64_SerializableError::bincodeDeserializeInto(Result_i64_SerializableError &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -818,6 +883,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void Result_void_SerializableError::bincodeDeserializeInto(Result_void_SerializableError &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -936,6 +1009,14 @@ namespace BUFFI_NAMESPACE {
         return value;
     }
 
+    inline void SerializableError::bincodeDeserializeInto(SerializableError &out, const std::vector<uint8_t> &input) {
+        auto deserializer = serde::BincodeDeserializer(input.data(), input.size());
+        serde::deserialize_into(out, deserializer);
+        if (deserializer.get_buffer_offset() < input.size()) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+    }
+
 } // end of namespace BUFFI_NAMESPACE
 
 template <>
@@ -955,3 +1036,71 @@ BUFFI_NAMESPACE::SerializableError serde::Deserializable<BUFFI_NAMESPACE::Serial
     deserializer.decrease_container_depth();
     return obj;
 }
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::CustomType>::deserialize_into(BUFFI_NAMESPACE::CustomType &obj, Deserializer &deserializer) {
+    deserializer.increase_container_depth();
+    serde::deserialize_into(obj.some_content, deserializer);
+    serde::deserialize_into(obj.itself, deserializer);
+    serde::deserialize_into(obj.random_enum, deserializer);
+    serde::deserialize_into(obj.proxy, deserializer);
+    serde::deserialize_into(obj.overwrite, deserializer);
+    serde::deserialize_into(obj.overwrite_2, deserializer);
+    serde::deserialize_into(obj.custom, deserializer);
+    deserializer.decrease_container_depth();
+}
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::DateTimeHelper>::deserialize_into(BUFFI_NAMESPACE::DateTimeHelper &obj, Deserializer &deserializer) {
+    deserializer.increase_container_depth();
+    serde::deserialize_into(obj.milliseconds_since_unix_epoch, deserializer);
+    deserializer.decrease_container_depth();
+}
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::Point1_f64>::deserialize_into(BUFFI_NAMESPACE::Point1_f64 &obj, Deserializer &deserializer) {
+    deserializer.increase_container_depth();
+    serde::deserialize_into(obj.x, deserializer);
+    deserializer.decrease_container_depth();
+}
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::RandomEnum>::deserialize_into(BUFFI_NAMESPACE::RandomEnum &obj, Deserializer &deserializer) {
+    obj = serde::Deserializable<BUFFI_NAMESPACE::RandomEnum>::deserialize(deserializer);
+}
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::Result_CustomType_SerializableError>::deserialize_into(BUFFI_NAMESPACE::Result_CustomType_SerializableError &obj, Deserializer &deserializer) {
+    obj = serde::Deserializable<BUFFI_NAMESPACE::Result_CustomType_SerializableError>::deserialize(deserializer);
+}
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::Result_String_SerializableError>::deserialize_into(BUFFI_NAMESPACE::Result_String_SerializableError &obj, Deserializer &deserializer) {
+    obj = serde::Deserializable<BUFFI_NAMESPACE::Result_String_SerializableError>::deserialize(deserializer);
+}
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::Result_i64_SerializableError>::deserialize_into(BUFFI_NAMESPACE::Result_i64_SerializableError &obj, Deserializer &deserializer) {
+    obj = serde::Deserializable<BUFFI_NAMESPACE::Result_i64_SerializableError>::deserialize(deserializer);
+}
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::Result_void_SerializableError>::deserialize_into(BUFFI_NAMESPACE::Result_void_SerializableError &obj, Deserializer &deserializer) {
+    obj = serde::Deserializable<BUFFI_NAMESPACE::Result_void_SerializableError>::deserialize(deserializer);
+}
+
+template <>
+template <typename Deserializer>
+void serde::Deserializable<BUFFI_NAMESPACE::SerializableError>::deserialize_into(BUFFI_NAMESPACE::SerializableError &obj, Deserializer &deserializer) {
+    deserializer.increase_container_depth();
+    serde::deserialize_into(obj.message, deserializer);
+    deserializer.decrease_container_depth();
+}
@@ -5,23 +5,114 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <memory_resource>
 #include <variant>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "serde.hpp"
 
 namespace serde {
 
-template <class S>
+// A fixed-capacity byte buffer exposing the slice of std::vector's
+// interface the serializers use. Bytes live inside the object and only move
+// to the heap if the payload outgrows the inline capacity, so small
+// payloads are serialized without any allocation.
+template <size_t N>
+class small_byte_buffer {
+  public:
+    small_byte_buffer() = default;
+
+    size_t size() const { return spilled_ ? heap_.size() : size_; }
+
+    uint8_t *data() { return spilled_ ? heap_.data() : inline_.data(); }
+    const uint8_t *data() const {
+        return spilled_ ? heap_.data() : inline_.data();
+    }
+
+    uint8_t *begin() { return data(); }
+    uint8_t *end() { return data() + size(); }
+
+    void push_back(uint8_t value) {
+        if (!spilled_) {
+            if (size_ < N) {
+                inline_[size_++] = value;
+                return;
+            }
+            spill(size_ + 1);
+        }
+        heap_.push_back(value);
+    }
+
+    // The serializers only ever append, so `position` must be end().
+    template <typename It>
+    void insert(uint8_t *position, It first, It last) {
+        assert(position == end());
+        (void)position;
+        size_t len = size_t(std::distance(first, last));
+        if (!spilled_ && size_ + len > N) {
+            spill(size_ + len);
+        }
+        if (spilled_) {
+            heap_.insert(heap_.end(), first, last);
+        } else {
+            std::copy(first, last, inline_.begin() + size_);
+            size_ += len;
+        }
+    }
+
+    void reserve(size_t capacity) {
+        if (spilled_) {
+            heap_.reserve(capacity);
+        } else if (capacity > N) {
+            spill(capacity);
+        }
+    }
+
+    void clear() {
+        heap_.clear();
+        spilled_ = false;
+        size_ = 0;
+    }
+
+  private:
+    void spill(size_t capacity) {
+        heap_.reserve(std::max(capacity, 2 * N));
+        heap_.assign(inline_.begin(), inline_.begin() + size_);
+        spilled_ = true;
+        size_ = 0;
+    }
+
+    std::array<uint8_t, N> inline_;
+    std::vector<uint8_t> heap_;
+    size_t size_ = 0;
+    bool spilled_ = false;
+};
+
+template <class S, class Storage = std::vector<uint8_t>>
 class BinarySerializer {
   protected:
-    std::vector<uint8_t> bytes_;
+    Storage bytes_;
     size_t container_depth_budget_;
 
   public:
     BinarySerializer(size_t max_container_depth)
         : container_depth_budget_(max_container_depth) {}
 
-    void serialize_str(const std::string &value);
+    // Adopt an existing buffer: its contents are discarded but its capacity
+    // is kept, so warmed buffers can be reused across calls.
+    BinarySerializer(std::vector<uint8_t> buffer, size_t max_container_depth)
+        : bytes_(std::move(buffer)),
+          container_depth_budget_(max_container_depth) {
+        bytes_.clear();
+    }
+
+    void serialize_str(std::string_view value);
 
     void serialize_bool(bool value);
     void serialize_unit();
@@ -41,11 +132,14 @@ class BinarySerializer {
     void serialize_i64(int64_t value);
     void serialize_i128(const int128_t &value);
     void serialize_option_tag(bool value);
+    void serialize_raw_bytes(const uint8_t *data, size_t len);
 
     size_t get_buffer_offset();
     void increase_container_depth();
     void decrease_container_depth();
 
+    void reserve(size_t size) { bytes_.reserve(size); }
+
     std::vector<uint8_t> bytes() && { return std::move(bytes_); }
 };
 
@@ -53,17 +147,43 @@ template <class D>
 class BinaryDeserializer {
     size_t pos_;
     size_t container_depth_budget_;
+    std::vector<uint8_t> owned_bytes_;
+    std::pmr::memory_resource *memory_resource_ =
+        std::pmr::get_default_resource();
 
   protected:
-    std::vector<uint8_t> bytes_;
+    const uint8_t *data_;
+    size_t size_;
     uint8_t read_byte();
+    const uint8_t *read_bytes(size_t len);
 
   public:
     BinaryDeserializer(std::vector<uint8_t> bytes, size_t max_container_depth)
         : pos_(0), container_depth_budget_(max_container_depth),
-          bytes_(std::move(bytes)) {}
+          owned_bytes_(std::move(bytes)), data_(owned_bytes_.data()),
+          size_(owned_bytes_.size()) {}
+
+    // Non-owning mode: deserialize directly from a borrowed buffer instead
+    // of copying it first. The buffer must outlive the deserializer.
+    BinaryDeserializer(const uint8_t *data, size_t size,
+                       size_t max_container_depth)
+        : pos_(0), container_depth_budget_(max_container_depth), data_(data),
+          size_(size) {}
 
     std::string deserialize_str();
+    std::string_view deserialize_str_view();
+    template <typename Str>
+    Str deserialize_str_into(Str result);
+
+    // Memory resource that allocator-aware containers are constructed from
+    // during deserialization (see `make_container` in serde.hpp); defaults
+    // to the global default resource.
+    std::pmr::memory_resource *get_memory_resource() const {
+        return memory_resource_;
+    }
+    void set_memory_resource(std::pmr::memory_resource *memory_resource) {
+        memory_resource_ = memory_resource;
+    }
 
     bool deserialize_bool();
     std::monostate deserialize_unit();
@@ -84,64 +204,63 @@ class BinaryDeserializer {
     int128_t deserialize_i128();
 
     bool deserialize_option_tag();
+    void deserialize_raw_bytes(uint8_t *dest, size_t len);
 
     size_t get_buffer_offset();
     void increase_container_depth();
     void decrease_container_depth();
 };
 
-template <class S>
-void BinarySerializer<S>::serialize_str(const std::string &value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_str(std::string_view value) {
     static_cast<S *>(this)->serialize_len(value.size());
-    for (auto c : value) {
-        bytes_.push_back(c);
-    }
+    bytes_.insert(bytes_.end(), value.begin(), value.end());
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_unit() {}
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_unit() {}
 
-template <class S>
-void BinarySerializer<S>::serialize_f32(float) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_f32(float) {
     throw serde::serialization_error("not implemented");
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_f64(double) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_f64(double) {
     throw serde::serialization_error("not implemented");
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_char(char32_t) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_char(char32_t) {
     throw serde::serialization_error("not implemented");
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_bool(bool value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_bool(bool value) {
     bytes_.push_back((uint8_t)value);
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_u8(uint8_t value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_u8(uint8_t value) {
     bytes_.push_back(value);
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_u16(uint16_t value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_u16(uint16_t value) {
     bytes_.push_back((uint8_t)value);
     bytes_.push_back((uint8_t)(value >> 8));
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_u32(uint32_t value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_u32(uint32_t value) {
     bytes_.push_back((uint8_t)value);
     bytes_.push_back((uint8_t)(value >> 8));
     bytes_.push_back((uint8_t)(value >> 16));
     bytes_.push_back((uint8_t)(value >> 24));
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_u64(uint64_t value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_u64(uint64_t value) {
     bytes_.push_back((uint8_t)value);
     bytes_.push_back((uint8_t)(value >> 8));
     bytes_.push_back((uint8_t)(value >> 16));
@@ -152,113 +271,202 @@ void BinarySerializer<S>::serialize_u64(uint64_t value) {
     bytes_.push_back((uint8_t)(value >> 56));
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_u128(const uint128_t &value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_u128(const uint128_t &value) {
     serialize_u64(value.low);
     serialize_u64(value.high);
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_i8(int8_t value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_i8(int8_t value) {
     serialize_u8((uint8_t)value);
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_i16(int16_t value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_i16(int16_t value) {
     serialize_u16((uint16_t)value);
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_i32(int32_t value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_i32(int32_t value) {
     serialize_u32((uint32_t)value);
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_i64(int64_t value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_i64(int64_t value) {
     serialize_u64((uint64_t)value);
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_i128(const int128_t &value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_i128(const int128_t &value) {
     serialize_u64(value.low);
     serialize_i64(value.high);
 }
 
-template <class S>
-void BinarySerializer<S>::serialize_option_tag(bool value) {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_option_tag(bool value) {
     serialize_bool(value);
 }
 
-template <class S>
-size_t BinarySerializer<S>::get_buffer_offset() {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::serialize_raw_bytes(const uint8_t *data, size_t len) {
+    bytes_.insert(bytes_.end(), data, data + len);
+}
+
+template <class S, class Storage>
+size_t BinarySerializer<S, Storage>::get_buffer_offset() {
     return bytes_.size();
 }
 
-template <class S>
-void BinarySerializer<S>::increase_container_depth() {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::increase_container_depth() {
     if (container_depth_budget_ == 0) {
         throw serialization_error("Too many nested containers");
     }
     container_depth_budget_--;
 }
 
-template <class S>
-void BinarySerializer<S>::decrease_container_depth() {
+template <class S, class Storage>
+void BinarySerializer<S, Storage>::decrease_container_depth() {
     container_depth_budget_++;
 }
 
 template <class D>
 uint8_t BinaryDeserializer<D>::read_byte() {
-    if (pos_ >= bytes_.size()) {
+    if (pos_ >= size_) {
         throw serde::deserialization_error("Input is not large enough");
     }
-    return bytes_.at(pos_++);
+    return data_[pos_++];
 }
 
-inline bool is_valid_utf8(const std::string &input) {
-    uint8_t trailing_digits = 0;
-    for (uint8_t byte : input) {
-        if (trailing_digits == 0) {
-            // Start new codepoint.
-            if (byte >> 7 == 0) {
-                // ASCII character
-            } else if (byte >> 5 == 0b110) {
-                // Expecting a 2-byte codepoint
-                trailing_digits = 1;
-            } else if (byte >> 4 == 0b1110) {
-                // Expecting a 3-byte codepoint
-                trailing_digits = 2;
-            } else if (byte >> 3 == 0b11110) {
-                // Expecting a 4-byte codepoint
-                trailing_digits = 3;
-            } else {
-                return false;
-            }
+// Checks the remaining input once, then hands out a pointer to the next
+// `len` bytes. All multi-byte reads are built on top of this.
+template <class D>
+const uint8_t *BinaryDeserializer<D>::read_bytes(size_t len) {
+    if (len > size_ - pos_) {
+        throw serde::deserialization_error("Input is not large enough");
+    }
+    const uint8_t *bytes = data_ + pos_;
+    pos_ += len;
+    return bytes;
+}
+
+// Returns the number of leading bytes of `[data, data + size)` that are
+// plain ASCII, scanning a vector register (where available) or a machine
+// word at a time instead of byte by byte.
+inline size_t ascii_prefix_length(const uint8_t *data, size_t size) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    while (i + 16 <= size) {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+        i += 16;
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    while (i + 16 <= size) {
+        if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80) {
+            break;
+        }
+        i += 16;
+    }
+#endif
+    while (i + 8 <= size) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if (word & UINT64_C(0x8080808080808080)) {
+            break;
+        }
+        i += 8;
+    }
+    while (i < size && data[i] >> 7 == 0) {
+        i++;
+    }
+    return i;
+}
+
+inline bool is_valid_utf8(const uint8_t *data, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        // Skip runs of ASCII characters in bulk.
+        i += ascii_prefix_length(data + i, size - i);
+        if (i == size) {
+            break;
+        }
+        // Decode a single multi-byte codepoint.
+        uint8_t byte = data[i];
+        uint8_t trailing_digits;
+        if (byte >> 5 == 0b110) {
+            // Expecting a 2-byte codepoint
+            trailing_digits = 1;
+        } else if (byte >> 4 == 0b1110) {
+            // Expecting a 3-byte codepoint
+            trailing_digits = 2;
+        } else if (byte >> 3 == 0b11110) {
+            // Expecting a 4-byte codepoint
+            trailing_digits = 3;
         } else {
-            // Process "trailing digit".
-            if (byte >> 6 != 0b10) {
+            return false;
+        }
+        if (trailing_digits > size - i - 1) {
+            return false;
+        }
+        // Process the "trailing digits".
+        for (uint8_t j = 1; j <= trailing_digits; j++) {
+            if (data[i + j] >> 6 != 0b10) {
                 return false;
             }
-            trailing_digits -= 1;
         }
+        i += size_t(trailing_digits) + 1;
     }
-    return trailing_digits == 0;
+    return true;
+}
+
+inline bool is_valid_utf8(const std::string &input) {
+    return is_valid_utf8(reinterpret_cast<const uint8_t *>(input.data()),
+                         input.size());
 }
 
 template <class D>
 std::string BinaryDeserializer<D>::deserialize_str() {
     auto len = static_cast<D *>(this)->deserialize_len();
-    std::string result;
-    result.reserve(len);
-    for (size_t i = 0; i < len; i++) {
-        result.push_back(read_byte());
-    }
+    const uint8_t *bytes = read_bytes(len);
+    std::string result(reinterpret_cast<const char *>(bytes), len);
     if (!is_valid_utf8(result)) {
         throw serde::deserialization_error("Invalid UTF8 string: " + result);
     }
     return result;
 }
 
+// Zero-copy variant: returns a view into the input buffer instead of
+// copying. The view is only valid as long as the input buffer lives, so use
+// it for strings that are inspected and dropped, not stored.
+template <class D>
+std::string_view BinaryDeserializer<D>::deserialize_str_view() {
+    auto len = static_cast<D *>(this)->deserialize_len();
+    const uint8_t *bytes = read_bytes(len);
+    if (!is_valid_utf8(bytes, len)) {
+        throw serde::deserialization_error("Invalid UTF8 string");
+    }
+    return std::string_view(reinterpret_cast<const char *>(bytes), len);
+}
+
+// Fills a caller-constructed (e.g. arena-backed) string with deserialized
+// content, so the bytes land directly in storage from the target allocator.
+template <class D>
+template <typename Str>
+Str BinaryDeserializer<D>::deserialize_str_into(Str result) {
+    auto len = static_cast<D *>(this)->deserialize_len();
+    const uint8_t *bytes = read_bytes(len);
+    if (!is_valid_utf8(bytes, len)) {
+        throw serde::deserialization_error("Invalid UTF8 string");
+    }
+    result.assign(reinterpret_cast<const char *>(bytes), len);
+    return result;
+}
+
 template <class D>
 std::monostate BinaryDeserializer<D>::deserialize_unit() {
     return {};
@@ -298,33 +506,33 @@ uint8_t BinaryDeserializer<D>::deserialize_u8() {
 
 template <class D>
 uint16_t BinaryDeserializer<D>::deserialize_u16() {
-    uint16_t val = 0;
-    val |= (uint16_t)read_byte();
-    val |= (uint16_t)read_byte() << 8;
+    const uint8_t *bytes = read_bytes(sizeof(uint16_t));
+    uint16_t val = (uint16_t)bytes[0];
+    val |= (uint16_t)bytes[1] << 8;
     return val;
 }
 
 template <class D>
 uint32_t BinaryDeserializer<D>::deserialize_u32() {
-    uint32_t val = 0;
-    val |= (uint32_t)read_byte();
-    val |= (uint32_t)read_byte() << 8;
-    val |= (uint32_t)read_byte() << 16;
-    val |= (uint32_t)read_byte() << 24;
+    const uint8_t *bytes = read_bytes(sizeof(uint32_t));
+    uint32_t val = (uint32_t)bytes[0];
+    val |= (uint32_t)bytes[1] << 8;
+    val |= (uint32_t)bytes[2] << 16;
+    val |= (uint32_t)bytes[3] << 24;
     return val;
 }
 
 template <class D>
 uint64_t BinaryDeserializer<D>::deserialize_u64() {
-    uint64_t val = 0;
-    val |= (uint64_t)read_byte();
-    val |= (uint64_t)read_byte() << 8;
-    val |= (uint64_t)read_byte() << 16;
-    val |= (uint64_t)read_byte() << 24;
-    val |= (uint64_t)read_byte() << 32;
-    val |= (uint64_t)read_byte() << 40;
-    val |= (uint64_t)read_byte() << 48;
-    val |= (uint64_t)read_byte() << 56;
+    const uint8_t *bytes = read_bytes(sizeof(uint64_t));
+    uint64_t val = (uint64_t)bytes[0];
+    val |= (uint64_t)bytes[1] << 8;
+    val |= (uint64_t)bytes[2] << 16;
+    val |= (uint64_t)bytes[3] << 24;
+    val |= (uint64_t)bytes[4] << 32;
+    val |= (uint64_t)bytes[5] << 40;
+    val |= (uint64_t)bytes[6] << 48;
+    val |= (uint64_t)bytes[7] << 56;
     return val;
 }
 
@@ -369,6 +577,12 @@ bool BinaryDeserializer<D>::deserialize_option_tag() {
     return deserialize_bool();
 }
 
+template <class D>
+void BinaryDeserializer<D>::deserialize_raw_bytes(uint8_t *dest, size_t len) {
+    const uint8_t *bytes = read_bytes(len);
+    std::copy(bytes, bytes + len, dest);
+}
+
 template <class D>
 size_t BinaryDeserializer<D>::get_buffer_offset() {
     return pos_;
@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 #include "binary.hpp"
 #include "serde.hpp"
@@ -20,6 +22,9 @@ class BincodeSerializer : public BinarySerializer<BincodeSerializer> {
   public:
     BincodeSerializer() : Parent(SIZE_MAX) {}
 
+    BincodeSerializer(std::vector<uint8_t> buffer)
+        : Parent(std::move(buffer), SIZE_MAX) {}
+
     void serialize_f32(float value);
     void serialize_f64(double value);
     void serialize_len(size_t value);
@@ -35,6 +40,9 @@ class BincodeDeserializer : public BinaryDeserializer<BincodeDeserializer> {
     BincodeDeserializer(std::vector<uint8_t> bytes)
         : Parent(std::move(bytes), SIZE_MAX) {}
 
+    BincodeDeserializer(const uint8_t *data, size_t size)
+        : Parent(data, size, SIZE_MAX) {}
+
     float deserialize_f32();
     double deserialize_f64();
     size_t deserialize_len();
@@ -43,6 +51,358 @@ class BincodeDeserializer : public BinaryDeserializer<BincodeDeserializer> {
     static constexpr bool enforce_strict_map_ordering = false;
 };
 
+// BincodeSerializer over stack storage, for small argument payloads whose
+// encoded size has a known bound: the bytes land in an in-object array (see
+// small_byte_buffer) and the serialized span is read in place via data() /
+// size() instead of being moved out, so the whole argument path stays
+// allocation-free. Spills to the heap if the payload outgrows N.
+template <size_t N>
+class SmallBincodeSerializer
+    : public BinarySerializer<SmallBincodeSerializer<N>, small_byte_buffer<N>> {
+    using Parent =
+        BinarySerializer<SmallBincodeSerializer<N>, small_byte_buffer<N>>;
+
+  public:
+    SmallBincodeSerializer() : Parent(SIZE_MAX) {}
+
+    void serialize_f32(float value) {
+        Parent::serialize_u32(*reinterpret_cast<uint32_t *>(&value));
+    }
+
+    void serialize_f64(double value) {
+        Parent::serialize_u64(*reinterpret_cast<uint64_t *>(&value));
+    }
+
+    void serialize_len(size_t value) {
+        if (value > BINCODE_MAX_LENGTH) {
+            throw serde::serialization_error("Length is too large");
+        }
+        Parent::serialize_u64((uint64_t)value);
+    }
+
+    void serialize_variant_index(uint32_t value) {
+        Parent::serialize_u32((uint32_t)value);
+    }
+
+    const uint8_t *data() const { return this->bytes_.data(); }
+    size_t size() const { return this->bytes_.size(); }
+
+    static constexpr bool enforce_strict_map_ordering = false;
+};
+
+// Compile-time bincode encoding for constant arguments: `preserialize`
+// turns an integral constant or string literal into its encoded bytes at
+// compile time, and the generated wrappers accept the resulting blob via
+// dedicated overloads that skip all runtime serialization work:
+//
+//     static constexpr auto input = serde::preserialize("fixed query");
+//     client.client_function(input);
+//
+// The encoding matches BincodeSerializer (fixed-width little-endian
+// integers, u64-length-prefixed strings), so the blobs cannot be used
+// together with varint encoding and the overloads are not generated for it.
+template <size_t N>
+struct preserialized {
+    std::array<uint8_t, N> bytes;
+
+    constexpr const uint8_t *data() const { return bytes.data(); }
+    constexpr size_t size() const { return N; }
+};
+
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value &&
+                                      !std::is_same<T, bool>::value,
+                                  int>::type = 0>
+constexpr preserialized<sizeof(T)> preserialize(T value) {
+    preserialized<sizeof(T)> out{};
+    auto bits = static_cast<typename std::make_unsigned<T>::type>(value);
+    for (size_t i = 0; i < sizeof(T); i++) {
+        out.bytes[i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+    return out;
+}
+
+constexpr preserialized<1> preserialize(bool value) {
+    return preserialized<1>{{value ? uint8_t(1) : uint8_t(0)}};
+}
+
+template <size_t N>
+constexpr preserialized<sizeof(uint64_t) + N - 1>
+preserialize(const char (&str)[N]) {
+    static_assert(N - 1 <= BINCODE_MAX_LENGTH, "String constant is too long");
+    preserialized<sizeof(uint64_t) + N - 1> out{};
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+        out.bytes[i] = static_cast<uint8_t>(uint64_t(N - 1) >> (8 * i));
+    }
+    for (size_t i = 0; i + 1 < N; i++) {
+        out.bytes[sizeof(uint64_t) + i] = static_cast<uint8_t>(str[i]);
+    }
+    return out;
+}
+
+// Varint counterparts of BincodeSerializer/BincodeDeserializer matching
+// bincode's `standard()` configuration on the Rust side: integers wider than
+// one byte (including lengths and variant indices) are written in the
+// smallest possible representation — values below 251 take a single byte,
+// larger ones a one-byte width marker (251/252/253/254) followed by the
+// fixed-width little-endian value. Signed integers are zigzag-encoded,
+// floats stay fixed width. For length-prefix-heavy payloads this shrinks
+// the wire size considerably.
+class BincodeCompactSerializer
+    : public BinarySerializer<BincodeCompactSerializer> {
+    using Parent = BinarySerializer<BincodeCompactSerializer>;
+
+    void serialize_varint(uint64_t value) {
+        if (value < 251) {
+            Parent::serialize_u8((uint8_t)value);
+        } else if (value <= UINT16_MAX) {
+            Parent::serialize_u8(251);
+            Parent::serialize_u16((uint16_t)value);
+        } else if (value <= UINT32_MAX) {
+            Parent::serialize_u8(252);
+            Parent::serialize_u32((uint32_t)value);
+        } else {
+            Parent::serialize_u8(253);
+            Parent::serialize_u64(value);
+        }
+    }
+
+    static uint64_t zigzag(int64_t value) {
+        return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+    }
+
+    static uint128_t zigzag128(const int128_t &value) {
+        uint64_t sign_mask = (uint64_t)(value.high >> 63);
+        uint128_t out;
+        out.high = (((uint64_t)value.high << 1) | (value.low >> 63)) ^
+                   sign_mask;
+        out.low = (value.low << 1) ^ sign_mask;
+        return out;
+    }
+
+  public:
+    BincodeCompactSerializer() : Parent(SIZE_MAX) {}
+
+    BincodeCompactSerializer(std::vector<uint8_t> buffer)
+        : Parent(std::move(buffer), SIZE_MAX) {}
+
+    void serialize_f32(float value) {
+        Parent::serialize_u32(*reinterpret_cast<uint32_t *>(&value));
+    }
+
+    void serialize_f64(double value) {
+        Parent::serialize_u64(*reinterpret_cast<uint64_t *>(&value));
+    }
+
+    void serialize_u16(uint16_t value) { serialize_varint(value); }
+    void serialize_u32(uint32_t value) { serialize_varint(value); }
+    void serialize_u64(uint64_t value) { serialize_varint(value); }
+
+    void serialize_u128(const uint128_t &value) {
+        if (value.high == 0) {
+            serialize_varint(value.low);
+        } else {
+            Parent::serialize_u8(254);
+            Parent::serialize_u128(value);
+        }
+    }
+
+    void serialize_i16(int16_t value) { serialize_varint(zigzag(value)); }
+    void serialize_i32(int32_t value) { serialize_varint(zigzag(value)); }
+    void serialize_i64(int64_t value) { serialize_varint(zigzag(value)); }
+
+    void serialize_i128(const int128_t &value) {
+        serialize_u128(zigzag128(value));
+    }
+
+    void serialize_len(size_t value) {
+        if (value > BINCODE_MAX_LENGTH) {
+            throw serde::serialization_error("Length is too large");
+        }
+        serialize_varint((uint64_t)value);
+    }
+
+    void serialize_variant_index(uint32_t value) { serialize_varint(value); }
+
+    static constexpr bool enforce_strict_map_ordering = false;
+    // multi-byte integers are varints, so sequences of them must not be
+    // block-copied (see the bulk path in serde.hpp)
+    static constexpr bool fixed_int_encoding = false;
+};
+
+class BincodeCompactDeserializer
+    : public BinaryDeserializer<BincodeCompactDeserializer> {
+    using Parent = BinaryDeserializer<BincodeCompactDeserializer>;
+
+    uint64_t deserialize_varint() {
+        uint8_t marker = Parent::deserialize_u8();
+        if (marker < 251) {
+            return marker;
+        } else if (marker == 251) {
+            return Parent::deserialize_u16();
+        } else if (marker == 252) {
+            return Parent::deserialize_u32();
+        } else if (marker == 253) {
+            return Parent::deserialize_u64();
+        }
+        throw serde::deserialization_error("Invalid varint width marker");
+    }
+
+    static int64_t unzigzag(uint64_t value) {
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    static int128_t unzigzag128(const uint128_t &value) {
+        uint64_t sign_mask = 0 - (value.low & 1);
+        int128_t out;
+        out.low = ((value.low >> 1) | (value.high << 63)) ^ sign_mask;
+        out.high = (int64_t)((value.high >> 1) ^ sign_mask);
+        return out;
+    }
+
+  public:
+    BincodeCompactDeserializer(std::vector<uint8_t> bytes)
+        : Parent(std::move(bytes), SIZE_MAX) {}
+
+    BincodeCompactDeserializer(const uint8_t *data, size_t size)
+        : Parent(data, size, SIZE_MAX) {}
+
+    float deserialize_f32() {
+        auto value = Parent::deserialize_u32();
+        return *reinterpret_cast<float *>(&value);
+    }
+
+    double deserialize_f64() {
+        auto value = Parent::deserialize_u64();
+        return *reinterpret_cast<double *>(&value);
+    }
+
+    uint16_t deserialize_u16() {
+        auto value = deserialize_varint();
+        if (value > UINT16_MAX) {
+            throw serde::deserialization_error("Varint is out of range");
+        }
+        return (uint16_t)value;
+    }
+
+    uint32_t deserialize_u32() {
+        auto value = deserialize_varint();
+        if (value > UINT32_MAX) {
+            throw serde::deserialization_error("Varint is out of range");
+        }
+        return (uint32_t)value;
+    }
+
+    uint64_t deserialize_u64() { return deserialize_varint(); }
+
+    uint128_t deserialize_u128() {
+        uint8_t marker = Parent::deserialize_u8();
+        if (marker == 254) {
+            return Parent::deserialize_u128();
+        }
+        uint128_t out;
+        out.high = 0;
+        if (marker < 251) {
+            out.low = marker;
+        } else if (marker == 251) {
+            out.low = Parent::deserialize_u16();
+        } else if (marker == 252) {
+            out.low = Parent::deserialize_u32();
+        } else if (marker == 253) {
+            out.low = Parent::deserialize_u64();
+        } else {
+            throw serde::deserialization_error("Invalid varint width marker");
+        }
+        return out;
+    }
+
+    int16_t deserialize_i16() {
+        auto value = unzigzag(deserialize_varint());
+        if (value < INT16_MIN || value > INT16_MAX) {
+            throw serde::deserialization_error("Varint is out of range");
+        }
+        return (int16_t)value;
+    }
+
+    int32_t deserialize_i32() {
+        auto value = unzigzag(deserialize_varint());
+        if (value < INT32_MIN || value > INT32_MAX) {
+            throw serde::deserialization_error("Varint is out of range");
+        }
+        return (int32_t)value;
+    }
+
+    int64_t deserialize_i64() { return unzigzag(deserialize_varint()); }
+
+    int128_t deserialize_i128() { return unzigzag128(deserialize_u128()); }
+
+    size_t deserialize_len() {
+        auto value = deserialize_varint();
+        if (value > BINCODE_MAX_LENGTH) {
+            throw serde::deserialization_error("Length is too large");
+        }
+        return (size_t)value;
+    }
+
+    uint32_t deserialize_variant_index() { return deserialize_u32(); }
+
+    static constexpr bool enforce_strict_map_ordering = false;
+    static constexpr bool fixed_int_encoding = false;
+};
+
+// A serializer that only computes the size of the bincode encoding of a
+// value without writing any bytes. Running it over a value first allows
+// reserving the real output buffer to its exact final size in one shot.
+class SizeCounter {
+    size_t size_ = 0;
+
+  public:
+    void serialize_str(std::string_view value) {
+        size_ += sizeof(uint64_t) + value.size();
+    }
+
+    void serialize_bool(bool) { size_ += sizeof(uint8_t); }
+    void serialize_unit() {}
+    void serialize_char(char32_t) {
+        throw serde::serialization_error("not implemented");
+    }
+    void serialize_f32(float) { size_ += sizeof(uint32_t); }
+    void serialize_f64(double) { size_ += sizeof(uint64_t); }
+
+    void serialize_u8(uint8_t) { size_ += sizeof(uint8_t); }
+    void serialize_u16(uint16_t) { size_ += sizeof(uint16_t); }
+    void serialize_u32(uint32_t) { size_ += sizeof(uint32_t); }
+    void serialize_u64(uint64_t) { size_ += sizeof(uint64_t); }
+    void serialize_u128(const uint128_t &) { size_ += 2 * sizeof(uint64_t); }
+
+    void serialize_i8(int8_t) { size_ += sizeof(uint8_t); }
+    void serialize_i16(int16_t) { size_ += sizeof(uint16_t); }
+    void serialize_i32(int32_t) { size_ += sizeof(uint32_t); }
+    void serialize_i64(int64_t) { size_ += sizeof(uint64_t); }
+    void serialize_i128(const int128_t &) { size_ += 2 * sizeof(uint64_t); }
+
+    void serialize_option_tag(bool) { size_ += sizeof(uint8_t); }
+    void serialize_raw_bytes(const uint8_t *, size_t len) { size_ += len; }
+    void serialize_len(size_t) { size_ += sizeof(uint64_t); }
+    void serialize_variant_index(uint32_t) { size_ += sizeof(uint32_t); }
+
+    size_t get_buffer_offset() { return size_; }
+    void increase_container_depth() {}
+    void decrease_container_depth() {}
+
+    size_t size() const { return size_; }
+
+    static constexpr bool enforce_strict_map_ordering = false;
+};
+
+// Computes the exact number of bytes the bincode encoding of `value` takes
+template <typename T>
+size_t serialized_size(const T &value) {
+    SizeCounter counter;
+    Serializable<T>::serialize(value, counter);
+    return counter.size();
+}
+
 // Native floats and doubles must be IEEE-754 values of the expected size.
 static_assert(std::numeric_limits<float>::is_iec559);
 static_assert(std::numeric_limits<double>::is_iec559);
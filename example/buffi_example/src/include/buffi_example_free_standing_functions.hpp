@@ -2,6 +2,8 @@
 
 #include <cstddef>
 #include <limits>
+#include <future>
+#include <string_view>
 #include "buffi_example_api_functions.hpp"
 
 #include "BUFFI_NAMESPACE.hpp"
@@ -9,27 +11,131 @@
 
 namespace BUFFI_NAMESPACE {
 
+    // Non-throwing variant of `free_standing_function`: an Err response is returned as a value
+    // instead of being thrown; protocol-level failures still throw
+    inline serde::expected<int64_t, SerializableError> try_free_standing_function(const int64_t& input) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        auto serializer_input = serde::SmallBincodeSerializer<8>();
+        serde::Serializable<int64_t>::serialize(input, serializer_input);
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, serializer_input.size());
+        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_free_standing_function_into(serializer_input.data(), serializer_input.size(), &result_buffer, [](void* ctx, size_t len) -> uint8_t* { try { auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); } catch (...) { return nullptr; } });
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+
+        auto deserializer = serde::BincodeDeserializer(result_buffer.data(), res_size);
+        Result_i64_SerializableError out = serde::Deserializable<Result_i64_SerializableError>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+        serde::BufferPool::release(std::move(result_buffer));
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("free_standing_function", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
+
+        if (out.value.index() == 0) { // Ok
+            auto ok = std::get<0>(std::move(out.value));
+            return std::get<0>(std::move(ok.value));
+        } else { // Err
+            auto err = std::get<1>(std::move(out.value));
+            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));
+        }
+    }
+
     // A function that is not part of an impl block
     inline int64_t free_standing_function(const int64_t& input) {
-        auto serializer_input = serde::BincodeSerializer();
-        serde::Serializable<int64_t>::serialize(input, serializer_input);
-        std::vector<uint8_t> input_serialized = std::move(serializer_input).bytes();
-        uint8_t* out_ptr = nullptr;
+        auto result = try_free_standing_function(input);
+        if (!result) {
+            throw result.error();
+        }
+        return std::move(result).value();
+    }
 
-        size_t res_size = buffi_free_standing_function(input_serialized.data(), input_serialized.size(), &out_ptr);
+    // `free_standing_function` overload taking arguments pre-serialized at compile time via
+    // `serde::preserialize`; constant arguments skip runtime serialization
+    template <size_t N0>
+    inline serde::expected<int64_t, SerializableError> try_free_standing_function(const serde::preserialized<N0>& input) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, input.size());
+        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();
 
-        std::vector<uint8_t> serialized_result(out_ptr, out_ptr + res_size);
-        Result_i64_SerializableError out = Result_i64_SerializableError::bincodeDeserialize(serialized_result);
-        buffi_free_byte_buffer(out_ptr, res_size);
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_free_standing_function_into(input.data(), input.size(), &result_buffer, [](void* ctx, size_t len) -> uint8_t* { try { auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); } catch (...) { return nullptr; } });
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+
+        auto deserializer = serde::BincodeDeserializer(result_buffer.data(), res_size);
+        Result_i64_SerializableError out = serde::Deserializable<Result_i64_SerializableError>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+        serde::BufferPool::release(std::move(result_buffer));
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("free_standing_function", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
 
         if (out.value.index() == 0) { // Ok
-            auto ok = std::get<0>(out.value);
-            return std::get<0>(ok.value);
+            auto ok = std::get<0>(std::move(out.value));
+            return std::get<0>(std::move(ok.value));
         } else { // Err
-            auto err = std::get<1>(out.value);
-            auto error = std::get<0>(err.value);
+            auto err = std::get<1>(std::move(out.value));
+            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));
+        }
+    }
+
+    // Pre-serialized overload of `free_standing_function`; see `serde::preserialize`
+    template <size_t N0>
+    inline int64_t free_standing_function(const serde::preserialized<N0>& input) {
+        auto result = try_free_standing_function(input);
+        if (!result) {
+            throw result.error();
+        }
+        return std::move(result).value();
+    }
+
+    // Batched variant of `free_standing_function` that crosses the FFI boundary only once
+    inline std::vector<int64_t> free_standing_function_batch(const std::vector<int64_t>& batch) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        auto serializer_batch = serde::BincodeSerializer(serde::BufferPool::acquire());
+        serializer_batch.reserve(serde::serialized_size(batch));
+        serde::Serializable<std::vector<int64_t>>::serialize(batch, serializer_batch);
+        std::vector<uint8_t> batch_serialized = std::move(serializer_batch).bytes();
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, batch_serialized.size());
+        uint8_t* out_ptr = nullptr;
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_free_standing_function_batch(batch_serialized.data(), batch_serialized.size(), &out_ptr);
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+        serde::BufferPool::release(std::move(batch_serialized));
+        struct ResultBufferGuard {
+            uint8_t* ptr;
+            size_t size;
+            ~ResultBufferGuard() { buffi_free_byte_buffer(ptr, size); }
+        } out_guard{out_ptr, res_size};
+
+        auto deserializer = serde::BincodeDeserializer(out_ptr, res_size);
+        if (deserializer.deserialize_variant_index() != 0) { // Err
+            auto error = serde::Deserializable<SerializableError>::deserialize(deserializer);
             throw error;
         }
+        std::vector<Result_i64_SerializableError> results = serde::Deserializable<std::vector<Result_i64_SerializableError>>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("free_standing_function_batch", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
+        std::vector<int64_t> out;
+        out.reserve(results.size());
+        for (auto& res : results) {
+            if (res.value.index() == 0) { // Ok
+                auto ok = std::get<0>(std::move(res.value));
+                out.push_back(std::get<0>(std::move(ok.value)));
+            } else { // Err
+                auto err = std::get<1>(std::move(res.value));
+                auto error = std::get<0>(std::move(err.value));
+                throw error;
+            }
+        }
+        return out;
     }
 
 
@@ -2,6 +2,12 @@
 
 #include <cstddef>
 #include <limits>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string_view>
 #include "buffi_example_api_functions.hpp"
 
 #include "BUFFI_NAMESPACE.hpp"
@@ -16,74 +22,506 @@ public:
         this->inner = ptr;
     }
 
+    // Non-throwing variant of `async_function`: an Err response is returned as a value
+    // instead of being thrown; protocol-level failures still throw
+    inline serde::expected<CustomType, SerializableError> try_async_function(const int64_t& content) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        auto serializer_content = serde::SmallBincodeSerializer<8>();
+        serde::Serializable<int64_t>::serialize(content, serializer_content);
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, serializer_content.size());
+        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_async_function_into(this->inner, serializer_content.data(), serializer_content.size(), &result_buffer, [](void* ctx, size_t len) -> uint8_t* { try { auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); } catch (...) { return nullptr; } });
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+
+        auto deserializer = serde::BincodeDeserializer(result_buffer.data(), res_size);
+        Result_CustomType_SerializableError out = serde::Deserializable<Result_CustomType_SerializableError>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+        serde::BufferPool::release(std::move(result_buffer));
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("async_function", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
+
+        if (out.value.index() == 0) { // Ok
+            auto ok = std::get<0>(std::move(out.value));
+            return std::get<0>(std::move(ok.value));
+        } else { // Err
+            auto err = std::get<1>(std::move(out.value));
+            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));
+        }
+    }
+
     // An async function that needs a `Runtime` to be executed and returns a more complex type
     inline CustomType async_function(const int64_t& content) {
-        auto serializer_content = serde::BincodeSerializer();
-        serde::Serializable<int64_t>::serialize(content, serializer_content);
-        std::vector<uint8_t> content_serialized = std::move(serializer_content).bytes();
-        uint8_t* out_ptr = nullptr;
+        auto result = try_async_function(content);
+        if (!result) {
+            throw result.error();
+        }
+        return std::move(result).value();
+    }
+
+    // `async_function` overload taking arguments pre-serialized at compile time via
+    // `serde::preserialize`; constant arguments skip runtime serialization
+    template <size_t N0>
+    inline serde::expected<CustomType, SerializableError> try_async_function(const serde::preserialized<N0>& content) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, content.size());
+        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();
 
-        size_t res_size = buffi_async_function(this->inner, content_serialized.data(), content_serialized.size(), &out_ptr);
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_async_function_into(this->inner, content.data(), content.size(), &result_buffer, [](void* ctx, size_t len) -> uint8_t* { try { auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); } catch (...) { return nullptr; } });
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
 
-        std::vector<uint8_t> serialized_result(out_ptr, out_ptr + res_size);
-        Result_CustomType_SerializableError out = Result_CustomType_SerializableError::bincodeDeserialize(serialized_result);
-        buffi_free_byte_buffer(out_ptr, res_size);
+        auto deserializer = serde::BincodeDeserializer(result_buffer.data(), res_size);
+        Result_CustomType_SerializableError out = serde::Deserializable<Result_CustomType_SerializableError>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+        serde::BufferPool::release(std::move(result_buffer));
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("async_function", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
 
         if (out.value.index() == 0) { // Ok
-            auto ok = std::get<0>(out.value);
-            return std::get<0>(ok.value);
+            auto ok = std::get<0>(std::move(out.value));
+            return std::get<0>(std::move(ok.value));
         } else { // Err
-            auto err = std::get<1>(out.value);
-            auto error = std::get<0>(err.value);
+            auto err = std::get<1>(std::move(out.value));
+            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));
+        }
+    }
+
+    // Pre-serialized overload of `async_function`; see `serde::preserialize`
+    template <size_t N0>
+    inline CustomType async_function(const serde::preserialized<N0>& content) {
+        auto result = try_async_function(content);
+        if (!result) {
+            throw result.error();
+        }
+        return std::move(result).value();
+    }
+
+    // Non-blocking variant of `async_function` that runs the call on a background thread
+    inline std::future<CustomType> async_function_async(const int64_t& content) {
+        return std::async(std::launch::async, [this, content]() { return this->async_function(content); });
+    }
+
+    // Batched variant of `async_function` that crosses the FFI boundary only once
+    inline std::vector<CustomType> async_function_batch(const std::vector<int64_t>& batch) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        auto serializer_batch = serde::BincodeSerializer(serde::BufferPool::acquire());
+        serializer_batch.reserve(serde::serialized_size(batch));
+        serde::Serializable<std::vector<int64_t>>::serialize(batch, serializer_batch);
+        std::vector<uint8_t> batch_serialized = std::move(serializer_batch).bytes();
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, batch_serialized.size());
+        uint8_t* out_ptr = nullptr;
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_async_function_batch(this->inner, batch_serialized.data(), batch_serialized.size(), &out_ptr);
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+        serde::BufferPool::release(std::move(batch_serialized));
+        struct ResultBufferGuard {
+            uint8_t* ptr;
+            size_t size;
+            ~ResultBufferGuard() { buffi_free_byte_buffer(ptr, size); }
+        } out_guard{out_ptr, res_size};
+
+        auto deserializer = serde::BincodeDeserializer(out_ptr, res_size);
+        if (deserializer.deserialize_variant_index() != 0) { // Err
+            auto error = serde::Deserializable<SerializableError>::deserialize(deserializer);
             throw error;
         }
+        std::vector<Result_CustomType_SerializableError> results = serde::Deserializable<std::vector<Result_CustomType_SerializableError>>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("async_function_batch", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
+        std::vector<CustomType> out;
+        out.reserve(results.size());
+        for (auto& res : results) {
+            if (res.value.index() == 0) { // Ok
+                auto ok = std::get<0>(std::move(res.value));
+                out.push_back(std::get<0>(std::move(ok.value)));
+            } else { // Err
+                auto err = std::get<1>(std::move(res.value));
+                auto error = std::get<0>(std::move(err.value));
+                throw error;
+            }
+        }
+        return out;
     }
 
-    // A function that might use context provided by a TestClient to do its thing
-    inline std::string client_function(const std::string& input) {
-        auto serializer_input = serde::BincodeSerializer();
-        serde::Serializable<std::string>::serialize(input, serializer_input);
+    // Non-throwing variant of `client_function`: an Err response is returned as a value
+    // instead of being thrown; protocol-level failures still throw
+    inline serde::expected<std::string, SerializableError> try_client_function(std::string_view input) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        auto serializer_input = serde::BincodeSerializer(serde::BufferPool::acquire());
+        serializer_input.reserve(serde::serialized_size(input));
+        serde::Serializable<std::string_view>::serialize(input, serializer_input);
         std::vector<uint8_t> input_serialized = std::move(serializer_input).bytes();
-        uint8_t* out_ptr = nullptr;
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, input_serialized.size());
+        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_client_function_into(this->inner, input_serialized.data(), input_serialized.size(), &result_buffer, [](void* ctx, size_t len) -> uint8_t* { try { auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); } catch (...) { return nullptr; } });
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+        serde::BufferPool::release(std::move(input_serialized));
+
+        auto deserializer = serde::BincodeDeserializer(result_buffer.data(), res_size);
+        Result_String_SerializableError out = serde::Deserializable<Result_String_SerializableError>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+        serde::BufferPool::release(std::move(result_buffer));
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("client_function", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
+
+        if (out.value.index() == 0) { // Ok
+            auto ok = std::get<0>(std::move(out.value));
+            return std::get<0>(std::move(ok.value));
+        } else { // Err
+            auto err = std::get<1>(std::move(out.value));
+            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));
+        }
+    }
+
+    // A function that might use context provided by a TestClient to do its thing
+    inline std::string client_function(std::string_view input) {
+        auto result = try_client_function(input);
+        if (!result) {
+            throw result.error();
+        }
+        return std::move(result).value();
+    }
+
+    // `client_function` overload taking arguments pre-serialized at compile time via
+    // `serde::preserialize`; constant arguments skip runtime serialization
+    template <size_t N0>
+    inline serde::expected<std::string, SerializableError> try_client_function(const serde::preserialized<N0>& input) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, input.size());
+        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();
 
-        size_t res_size = buffi_client_function(this->inner, input_serialized.data(), input_serialized.size(), &out_ptr);
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_client_function_into(this->inner, input.data(), input.size(), &result_buffer, [](void* ctx, size_t len) -> uint8_t* { try { auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); } catch (...) { return nullptr; } });
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
 
-        std::vector<uint8_t> serialized_result(out_ptr, out_ptr + res_size);
-        Result_String_SerializableError out = Result_String_SerializableError::bincodeDeserialize(serialized_result);
-        buffi_free_byte_buffer(out_ptr, res_size);
+        auto deserializer = serde::BincodeDeserializer(result_buffer.data(), res_size);
+        Result_String_SerializableError out = serde::Deserializable<Result_String_SerializableError>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+        serde::BufferPool::release(std::move(result_buffer));
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("client_function", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
 
         if (out.value.index() == 0) { // Ok
-            auto ok = std::get<0>(out.value);
-            return std::get<0>(ok.value);
+            auto ok = std::get<0>(std::move(out.value));
+            return std::get<0>(std::move(ok.value));
         } else { // Err
-            auto err = std::get<1>(out.value);
-            auto error = std::get<0>(err.value);
+            auto err = std::get<1>(std::move(out.value));
+            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));
+        }
+    }
+
+    // Pre-serialized overload of `client_function`; see `serde::preserialize`
+    template <size_t N0>
+    inline std::string client_function(const serde::preserialized<N0>& input) {
+        auto result = try_client_function(input);
+        if (!result) {
+            throw result.error();
+        }
+        return std::move(result).value();
+    }
+
+    // Batched variant of `client_function` that crosses the FFI boundary only once
+    inline std::vector<std::string> client_function_batch(const std::vector<std::string>& batch) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        auto serializer_batch = serde::BincodeSerializer(serde::BufferPool::acquire());
+        serializer_batch.reserve(serde::serialized_size(batch));
+        serde::Serializable<std::vector<std::string>>::serialize(batch, serializer_batch);
+        std::vector<uint8_t> batch_serialized = std::move(serializer_batch).bytes();
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, batch_serialized.size());
+        uint8_t* out_ptr = nullptr;
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_client_function_batch(this->inner, batch_serialized.data(), batch_serialized.size(), &out_ptr);
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+        serde::BufferPool::release(std::move(batch_serialized));
+        struct ResultBufferGuard {
+            uint8_t* ptr;
+            size_t size;
+            ~ResultBufferGuard() { buffi_free_byte_buffer(ptr, size); }
+        } out_guard{out_ptr, res_size};
+
+        auto deserializer = serde::BincodeDeserializer(out_ptr, res_size);
+        if (deserializer.deserialize_variant_index() != 0) { // Err
+            auto error = serde::Deserializable<SerializableError>::deserialize(deserializer);
             throw error;
         }
+        std::vector<Result_String_SerializableError> results = serde::Deserializable<std::vector<Result_String_SerializableError>>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("client_function_batch", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
+        std::vector<std::string> out;
+        out.reserve(results.size());
+        for (auto& res : results) {
+            if (res.value.index() == 0) { // Ok
+                auto ok = std::get<0>(std::move(res.value));
+                out.push_back(std::get<0>(std::move(ok.value)));
+            } else { // Err
+                auto err = std::get<1>(std::move(res.value));
+                auto error = std::get<0>(std::move(err.value));
+                throw error;
+            }
+        }
+        return out;
     }
 
-    // Here we use a type from a third party crate and return `()`
-    inline void use_foreign_type_and_return_nothing(const Point1_f64& point) {
-        auto serializer_point = serde::BincodeSerializer();
+    // Non-throwing variant of `use_foreign_type_and_return_nothing`: an Err response is returned as a value
+    // instead of being thrown; protocol-level failures still throw
+    inline serde::expected<void, SerializableError> try_use_foreign_type_and_return_nothing(const Point1_f64& point) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        auto serializer_point = serde::BincodeSerializer(serde::BufferPool::acquire());
+        serializer_point.reserve(serde::serialized_size(point));
         serde::Serializable<Point1_f64>::serialize(point, serializer_point);
         std::vector<uint8_t> point_serialized = std::move(serializer_point).bytes();
-        uint8_t* out_ptr = nullptr;
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, point_serialized.size());
+        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();
 
-        size_t res_size = buffi_use_foreign_type_and_return_nothing(this->inner, point_serialized.data(), point_serialized.size(), &out_ptr);
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_use_foreign_type_and_return_nothing_into(this->inner, point_serialized.data(), point_serialized.size(), &result_buffer, [](void* ctx, size_t len) -> uint8_t* { try { auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); } catch (...) { return nullptr; } });
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+        serde::BufferPool::release(std::move(point_serialized));
 
-        std::vector<uint8_t> serialized_result(out_ptr, out_ptr + res_size);
-        Result_void_SerializableError out = Result_void_SerializableError::bincodeDeserialize(serialized_result);
-        buffi_free_byte_buffer(out_ptr, res_size);
+        auto deserializer = serde::BincodeDeserializer(result_buffer.data(), res_size);
+        Result_void_SerializableError out = serde::Deserializable<Result_void_SerializableError>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+        serde::BufferPool::release(std::move(result_buffer));
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("use_foreign_type_and_return_nothing", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
 
         if (out.value.index() == 0) { // Ok
-            return;
+            return {};
+        } else { // Err
+            auto err = std::get<1>(std::move(out.value));
+            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));
+        }
+    }
+
+    // Here we use a type from a third party crate and return `()`
+    inline void use_foreign_type_and_return_nothing(const Point1_f64& point) {
+        auto result = try_use_foreign_type_and_return_nothing(point);
+        if (!result) {
+            throw result.error();
+        }
+    }
+
+    // `use_foreign_type_and_return_nothing` overload taking arguments pre-serialized at compile time via
+    // `serde::preserialize`; constant arguments skip runtime serialization
+    template <size_t N0>
+    inline serde::expected<void, SerializableError> try_use_foreign_type_and_return_nothing(const serde::preserialized<N0>& point) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, point.size());
+        std::vector<uint8_t> result_buffer = serde::BufferPool::acquire();
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_use_foreign_type_and_return_nothing_into(this->inner, point.data(), point.size(), &result_buffer, [](void* ctx, size_t len) -> uint8_t* { try { auto& buffer = *static_cast<std::vector<uint8_t>*>(ctx); buffer.resize(len); return buffer.data(); } catch (...) { return nullptr; } });
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+
+        auto deserializer = serde::BincodeDeserializer(result_buffer.data(), res_size);
+        Result_void_SerializableError out = serde::Deserializable<Result_void_SerializableError>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+        serde::BufferPool::release(std::move(result_buffer));
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("use_foreign_type_and_return_nothing", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
+
+        if (out.value.index() == 0) { // Ok
+            return {};
         } else { // Err
-            auto err = std::get<1>(out.value);
-            auto error = std::get<0>(err.value);
+            auto err = std::get<1>(std::move(out.value));
+            return serde::unexpected<SerializableError>(std::get<0>(std::move(err.value)));
+        }
+    }
+
+    // Pre-serialized overload of `use_foreign_type_and_return_nothing`; see `serde::preserialize`
+    template <size_t N0>
+    inline void use_foreign_type_and_return_nothing(const serde::preserialized<N0>& point) {
+        auto result = try_use_foreign_type_and_return_nothing(point);
+        if (!result) {
+            throw result.error();
+        }
+    }
+
+    // Batched variant of `use_foreign_type_and_return_nothing` that crosses the FFI boundary only once
+    inline void use_foreign_type_and_return_nothing_batch(const std::vector<Point1_f64>& batch) {
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_start);
+        auto serializer_batch = serde::BincodeSerializer(serde::BufferPool::acquire());
+        serializer_batch.reserve(serde::serialized_size(batch));
+        serde::Serializable<std::vector<Point1_f64>>::serialize(batch, serializer_batch);
+        std::vector<uint8_t> batch_serialized = std::move(serializer_batch).bytes();
+        BUFFI_INSTRUMENT_BYTES(buffi_arg_bytes, batch_serialized.size());
+        uint8_t* out_ptr = nullptr;
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_serialized);
+        size_t res_size = buffi_use_foreign_type_and_return_nothing_batch(this->inner, batch_serialized.data(), batch_serialized.size(), &out_ptr);
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_returned);
+        serde::BufferPool::release(std::move(batch_serialized));
+        struct ResultBufferGuard {
+            uint8_t* ptr;
+            size_t size;
+            ~ResultBufferGuard() { buffi_free_byte_buffer(ptr, size); }
+        } out_guard{out_ptr, res_size};
+
+        auto deserializer = serde::BincodeDeserializer(out_ptr, res_size);
+        if (deserializer.deserialize_variant_index() != 0) { // Err
+            auto error = serde::Deserializable<SerializableError>::deserialize(deserializer);
             throw error;
         }
+        std::vector<Result_void_SerializableError> results = serde::Deserializable<std::vector<Result_void_SerializableError>>::deserialize(deserializer);
+        if (deserializer.get_buffer_offset() < res_size) {
+            throw serde::deserialization_error("Some input bytes were not read");
+        }
+
+        BUFFI_INSTRUMENT_TIMESTAMP(buffi_t_deserialized);
+        BUFFI_INSTRUMENT_CALL("use_foreign_type_and_return_nothing_batch", buffi_arg_bytes, res_size, buffi_t_serialized - buffi_t_start, buffi_t_returned - buffi_t_serialized, buffi_t_deserialized - buffi_t_returned);
+        for (auto& res : results) {
+            if (res.value.index() != 0) { // Err
+                auto err = std::get<1>(std::move(res.value));
+                auto error = std::get<0>(std::move(err.value));
+                throw error;
+            }
+        }
+    }
+
+};
+
+// A thread-safe pool of TestClient* handles for concurrent callers. Each
+// thread keeps affinity with the handle it released last (checked without
+// locking), then falls back to the mutex-guarded shared free list, and
+// finally to the user-supplied factory when the pool runs dry. Handles are
+// checked out RAII-style; every handle created through the pool is
+// destroyed with it, so the pool must outlive all checkouts and should
+// normally live for the whole program.
+class TestClientHolderPool {
+public:
+    TestClientHolderPool(std::function<TestClient*()> factory, std::function<void(TestClient*)> destroy = {})
+        : factory_(std::move(factory)), destroy_(std::move(destroy)) {
+    }
+
+    TestClientHolderPool(const TestClientHolderPool&) = delete;
+    TestClientHolderPool& operator=(const TestClientHolderPool&) = delete;
+
+    ~TestClientHolderPool() {
+        if (!destroy_) {
+            return;
+        }
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (TestClient* handle : owned_) {
+            destroy_(handle);
+        }
+    }
+
+    // RAII checkout: behaves like a TestClientHolder and returns the handle to
+    // the pool when it goes out of scope.
+    class Checkout {
+    public:
+        Checkout(TestClientHolderPool* pool, TestClient* handle) : pool_(pool), holder_(handle), handle_(handle) {
+        }
+        Checkout(Checkout&& other) : pool_(other.pool_), holder_(other.handle_), handle_(other.handle_) {
+            other.pool_ = nullptr;
+        }
+        Checkout(const Checkout&) = delete;
+        Checkout& operator=(const Checkout&) = delete;
+        Checkout& operator=(Checkout&&) = delete;
+        ~Checkout() {
+            if (pool_ != nullptr) {
+                pool_->put_back(handle_);
+            }
+        }
+
+        TestClientHolder* operator->() { return &holder_; }
+        TestClientHolder& operator*() { return holder_; }
+
+    private:
+        TestClientHolderPool* pool_;
+        TestClientHolder holder_;
+        TestClient* handle_;
+    };
+
+    Checkout acquire() {
+        TestClient** slot = affinity_slot();
+        if (*slot != nullptr) {
+            TestClient* handle = *slot;
+            *slot = nullptr;
+            return Checkout(this, handle);
+        }
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (!free_.empty()) {
+                TestClient* handle = free_.back();
+                free_.pop_back();
+                return Checkout(this, handle);
+            }
+        }
+        TestClient* handle = factory_();
+        std::lock_guard<std::mutex> guard(mutex_);
+        owned_.push_back(handle);
+        return Checkout(this, handle);
+    }
+
+private:
+    void put_back(TestClient* handle) {
+        TestClient** slot = affinity_slot();
+        if (*slot == nullptr) {
+            *slot = handle;
+            return;
+        }
+        std::lock_guard<std::mutex> guard(mutex_);
+        free_.push_back(handle);
+    }
+
+    // One cached handle per thread and pool: the common acquire/release
+    // cycle on a steady thread never touches the shared lock. Slots are
+    // keyed by a unique pool id rather than only the pool address, so
+    // entries left behind by a destroyed pool are never handed out again
+    // by a later pool allocated at the same address.
+    struct AffinitySlot {
+        uint64_t pool_id;
+        TestClient* handle;
+    };
+
+    TestClient** affinity_slot() {
+        thread_local std::map<const TestClientHolderPool*, AffinitySlot> slots;
+        AffinitySlot& slot = slots[this];
+        if (slot.pool_id != id_) {
+            slot.pool_id = id_;
+            slot.handle = nullptr;
+        }
+        return &slot.handle;
+    }
+
+    static uint64_t next_pool_id() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1) + 1;
     }
 
+    std::function<TestClient*()> factory_;
+    std::function<void(TestClient*)> destroy_;
+    const uint64_t id_ = next_pool_id();
+    std::mutex mutex_;
+    std::vector<TestClient*> free_;
+    std::vector<TestClient*> owned_;
 };
 
 }  // end of namespace BUFFI_NAMESPACE
@@ -0,0 +1,243 @@
+// Tests for the vendored C++ serde runtime.
+//
+// Build and run with `make run` in this directory; `cargo test -p tests`
+// runs it as well.
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "BUFFI_NAMESPACE.hpp"
+
+using namespace BUFFI_NAMESPACE;
+
+namespace {
+
+template <typename T>
+std::vector<uint8_t> compact_encode(const T &value) {
+    auto serializer = serde::BincodeCompactSerializer();
+    serde::Serializable<T>::serialize(value, serializer);
+    return std::move(serializer).bytes();
+}
+
+template <typename T>
+T compact_decode(const std::vector<uint8_t> &bytes) {
+    auto deserializer =
+        serde::BincodeCompactDeserializer(bytes.data(), bytes.size());
+    T out = serde::Deserializable<T>::deserialize(deserializer);
+    assert(deserializer.get_buffer_offset() == bytes.size());
+    return out;
+}
+
+template <typename T>
+void compact_round_trip(const T &value) {
+    assert(compact_decode<T>(compact_encode(value)) == value);
+}
+
+template <typename T>
+bool compact_decode_throws(const std::vector<uint8_t> &bytes) {
+    try {
+        auto deserializer =
+            serde::BincodeCompactDeserializer(bytes.data(), bytes.size());
+        serde::Deserializable<T>::deserialize(deserializer);
+    } catch (const serde::deserialization_error &) {
+        return true;
+    }
+    return false;
+}
+
+// The varint codec behind `BincodeCompactSerializer`/`Deserializer` must
+// match bincode's `standard()` configuration byte for byte, switch widths
+// exactly at the 251/252/253 markers and reject markers it never emits.
+void test_varint_codec() {
+    // known encodings from bincode's varint spec
+    assert(compact_encode<uint64_t>(5) == (std::vector<uint8_t>{5}));
+    assert(compact_encode<uint64_t>(250) == (std::vector<uint8_t>{250}));
+    assert(compact_encode<uint64_t>(251) == (std::vector<uint8_t>{251, 251, 0}));
+    assert(compact_encode<uint64_t>(300) ==
+           (std::vector<uint8_t>{251, 0x2c, 0x01}));
+    assert(compact_encode<uint64_t>(65535) ==
+           (std::vector<uint8_t>{251, 0xff, 0xff}));
+    assert(compact_encode<uint64_t>(65536) ==
+           (std::vector<uint8_t>{252, 0x00, 0x00, 0x01, 0x00}));
+    assert(compact_encode<uint64_t>(70000) ==
+           (std::vector<uint8_t>{252, 0x70, 0x11, 0x01, 0x00}));
+    assert(compact_encode<uint64_t>(0xffff'ffffull) ==
+           (std::vector<uint8_t>{252, 0xff, 0xff, 0xff, 0xff}));
+    assert(compact_encode<uint64_t>(0x1'0000'0000ull) ==
+           (std::vector<uint8_t>{253, 0, 0, 0, 0, 1, 0, 0, 0}));
+    // zigzag for signed values: 0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3
+    assert(compact_encode<int32_t>(0) == (std::vector<uint8_t>{0}));
+    assert(compact_encode<int32_t>(-1) == (std::vector<uint8_t>{1}));
+    assert(compact_encode<int32_t>(1) == (std::vector<uint8_t>{2}));
+    assert(compact_encode<int32_t>(-2) == (std::vector<uint8_t>{3}));
+
+    // round-trips across the width boundaries and the integer types
+    for (int64_t v : {int64_t(0), int64_t(-1), int64_t(125), int64_t(-126),
+                      int64_t(65536), int64_t(-4294967296), INT64_MIN,
+                      INT64_MAX}) {
+        compact_round_trip<int64_t>(v);
+    }
+    for (uint64_t v : {uint64_t(0), uint64_t(250), uint64_t(251),
+                       uint64_t(65535), uint64_t(65536), uint64_t(0xffff'ffff),
+                       uint64_t(0x1'0000'0000), UINT64_MAX}) {
+        compact_round_trip<uint64_t>(v);
+    }
+    compact_round_trip<uint16_t>(65535);
+    compact_round_trip<int16_t>(-32768);
+    compact_round_trip<serde::uint128_t>(serde::uint128_t{0, 42});
+    compact_round_trip<serde::uint128_t>(
+        serde::uint128_t{UINT64_MAX, UINT64_MAX});
+    compact_round_trip<serde::int128_t>(serde::int128_t{-1, UINT64_MAX});
+    compact_round_trip<serde::int128_t>(serde::int128_t{INT64_MIN, 0});
+    compact_round_trip<double>(3.14159);
+    compact_round_trip<float>(2.5f);
+
+    // string and sequence lengths use the varint too
+    std::vector<std::string> strings(10, "abc");
+    auto bytes = compact_encode(strings);
+    assert(bytes.size() == 1 + 10 * 4);
+    assert(compact_decode<std::vector<std::string>>(bytes) == strings);
+
+    // the bulk u8 path block-copies, wider element types must not
+    compact_round_trip(std::vector<uint8_t>(300, 7));
+    std::vector<uint32_t> ints = {1, 250, 251, 70000, UINT32_MAX};
+    auto int_bytes = compact_encode(ints);
+    assert(int_bytes.size() == 1 + 1 + 1 + 3 + 5 + 5);
+    assert(compact_decode<std::vector<uint32_t>>(int_bytes) == ints);
+
+    // variant indices go through the varint as well
+    std::variant<std::monostate, uint8_t> var = uint8_t{9};
+    assert(compact_encode(var) == (std::vector<uint8_t>{1, 9}));
+    compact_round_trip(var);
+
+    // markers 254 and 255 are never produced and must be rejected
+    assert(compact_decode_throws<uint64_t>({254}));
+    assert(compact_decode_throws<uint64_t>({255}));
+    // a decoded value that does not fit the target type must be rejected
+    assert(compact_decode_throws<uint16_t>({252, 0xff, 0xff, 0xff, 0xff}));
+    // a marker without its payload must not read past the buffer
+    assert(compact_decode_throws<uint64_t>({251, 0x01}));
+}
+
+bool lz4_decode_throws(const std::vector<uint8_t> &block, size_t raw_size) {
+    std::vector<uint8_t> out(raw_size);
+    try {
+        serde::lz4_decompress_block(block.data(), block.size(), out.data(),
+                                    out.size());
+    } catch (const serde::deserialization_error &) {
+        return true;
+    }
+    return false;
+}
+
+// Frames an LZ4 block the way the Rust side's `compressed_payloads`
+// feature does: tag byte 1 followed by the raw length as a u64 le.
+std::vector<uint8_t> frame_compressed(const std::vector<uint8_t> &block,
+                                      uint64_t raw_len) {
+    std::vector<uint8_t> framed;
+    framed.push_back(1);
+    for (int i = 0; i < 8; ++i) {
+        framed.push_back(uint8_t(raw_len >> (8 * i)));
+    }
+    framed.insert(framed.end(), block.begin(), block.end());
+    return framed;
+}
+
+// `lz4_decompress_block` parses untrusted response bytes, so beyond the
+// happy paths it must throw on malformed input instead of reading or
+// writing out of bounds.
+void test_lz4_decoder() {
+    // literals-only block: token 0x80, 8 literal bytes, no match
+    {
+        std::vector<uint8_t> block = {0x80, 'a', 'b', 'c', 'd',
+                                      'e',  'f', 'g', 'h'};
+        std::vector<uint8_t> out(8);
+        serde::lz4_decompress_block(block.data(), block.size(), out.data(),
+                                    out.size());
+        assert(std::string(out.begin(), out.end()) == "abcdefgh");
+    }
+    // overlapping match: one literal 'a', then a 15-byte match at offset 1
+    // replicates it into 16 a's
+    {
+        std::vector<uint8_t> block = {0x1B, 'a', 0x01, 0x00};
+        std::vector<uint8_t> out(16);
+        serde::lz4_decompress_block(block.data(), block.size(), out.data(),
+                                    out.size());
+        assert(std::string(out.begin(), out.end()) == std::string(16, 'a'));
+    }
+    // extended literal length: 20 literals need token 0xF0 plus an
+    // extension byte of 5
+    {
+        std::vector<uint8_t> block = {0xF0, 5};
+        for (int i = 0; i < 20; ++i) {
+            block.push_back(uint8_t('A' + i));
+        }
+        std::vector<uint8_t> out(20);
+        serde::lz4_decompress_block(block.data(), block.size(), out.data(),
+                                    out.size());
+        assert(out[0] == 'A' && out[19] == 'A' + 19);
+    }
+    // block claims 9 literals but carries 1
+    assert(lz4_decode_throws({0x90, 'a'}, 9));
+    // match offset 5 points before the start of the produced output
+    assert(lz4_decode_throws({0x1B, 'a', 0x05, 0x00}, 16));
+    // match offset 0 is never valid
+    assert(lz4_decode_throws({0x1B, 'a', 0x00, 0x00}, 16));
+    // truncated match: token promises a match but the offset is missing
+    assert(lz4_decode_throws({0x1B, 'a', 0x01}, 16));
+    // match overflows the declared output size
+    assert(lz4_decode_throws({0x1B, 'a', 0x01, 0x00}, 8));
+    // block decodes to fewer bytes than the frame declared
+    assert(lz4_decode_throws({0x80, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'},
+                             9));
+}
+
+bool payload_decode_throws(std::vector<uint8_t> buffer, size_t size) {
+    try {
+        serde::decode_compressed_payload(std::move(buffer), size);
+    } catch (const serde::deserialization_error &) {
+        return true;
+    }
+    return false;
+}
+
+// The tag-byte framing in front of every `compressed_payloads` response:
+// 0 marks a raw payload served from the original buffer, 1 marks an LZ4
+// block prefixed with its raw length.
+void test_compressed_payload_framing() {
+    // raw passthrough is zero-copy behind a one-byte offset
+    {
+        std::vector<uint8_t> buffer = {0, 1, 2, 3};
+        auto view = serde::decode_compressed_payload(std::move(buffer), 4);
+        assert(view.offset == 1 && view.size == 3);
+        assert(view.data()[0] == 1 && view.data()[2] == 3);
+    }
+    // a compressed frame round-trips through the decoder
+    {
+        std::vector<uint8_t> block = {0x1B, 'a', 0x01, 0x00};
+        auto framed = frame_compressed(block, 16);
+        size_t size = framed.size();
+        auto view = serde::decode_compressed_payload(std::move(framed), size);
+        assert(view.offset == 0 && view.size == 16);
+        assert(std::string(view.data(), view.data() + view.size) ==
+               std::string(16, 'a'));
+    }
+    // empty responses, unknown tags and truncated headers are rejected
+    assert(payload_decode_throws({}, 0));
+    assert(payload_decode_throws({2, 0}, 2));
+    assert(payload_decode_throws({1, 0, 0}, 3));
+}
+
+} // namespace
+
+int main() {
+    test_varint_codec();
+    test_lz4_decoder();
+    test_compressed_payload_framing();
+    std::cout << "runtime tests ok" << std::endl;
+    return 0;
+}
@@ -4,6 +4,26 @@ mod tests {
     use std::env::temp_dir;
     use std::fs;
     use std::path::PathBuf;
+    use std::process::Command;
+
+    #[test]
+    fn test_cpp_runtime() {
+        // build and run the C++ runtime tests in tests/cpp
+        let mut cpp_dir = PathBuf::from(env!("CARGO_MANIFEST_DIR"));
+        cpp_dir.push("cpp");
+
+        let output = Command::new("make")
+            .arg("run")
+            .current_dir(&cpp_dir)
+            .output()
+            .expect("Failed to invoke make");
+        assert!(
+            output.status.success(),
+            "C++ runtime tests failed:\n{}\n{}",
+            String::from_utf8_lossy(&output.stdout),
+            String::from_utf8_lossy(&output.stderr),
+        );
+    }
 
     #[test]
     fn test_basic_example() {